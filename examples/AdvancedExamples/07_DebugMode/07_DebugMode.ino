@@ -3,11 +3,14 @@
 const int DHT_PIN = 2;     // Pin where DHT sensor is connected
 MyDHT dht(DHT_PIN, DHT11); // Create sensor object (DHT11 or DHT22)
 
+DHTTraceRecord traceBuffer[24]; // Debug events are recorded here during a read
+
 void setup()
 {
     Serial.begin(115200);
     dht.begin(); // Initialize sensor
     dht.debugMode = true;
+    DHTTrace::begin(traceBuffer, 24); // Without a buffer debugMode records nothing
 
     Serial.println("=== MyDHT Library DEBUG_MODE Example ===");
 }
@@ -19,6 +22,10 @@ void loop()
     // Perform a sensor read
     DHTError err = dht.read();
 
+    // Print the debug messages after the read, so printing does not disturb its timing.
+    // DHTTrace::flush(Serial) sends them in binary instead (decode with extras/dhttrace).
+    DHTTrace::print(Serial);
+
     if (err == DHT_OK)
     {
         // Print temperature, humidity, dew point, heat index
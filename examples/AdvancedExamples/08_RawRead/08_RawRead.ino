@@ -20,7 +20,7 @@ void loop()
 
     if (err == DHT_OK)
     {
-        DHTRawData raw = dht.getRawData();
+        DHTRawView raw = dht.getRawView(); // No copy: points into the sensor's own buffers
 
         Serial.println("Raw bit timings:");
         for (int i = 0; i < 40; i++)
@@ -6,7 +6,7 @@ MyDHT sensor1(2, DHT11);
 MyDHT sensor2(3, DHT22);
 
 // Create manager
-MultiDHTManager manager;
+MultiDHTManager<> manager; // Up to MAX_SENSORS sensors
 
 DHTResult results[MAX_SENSORS];
 
@@ -25,6 +25,9 @@ void setup()
     manager.addSensor(sensor1);
     manager.addSensor(sensor2);
 
+    // Optional: read sensors on the same GPIO port together (pins 2 and 3 share PORTD on Uno)
+    // manager.setGroupRead(true);
+
     Serial.println("Multi-sensor demo started");
 }
 
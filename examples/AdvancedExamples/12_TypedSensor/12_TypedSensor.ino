@@ -0,0 +1,48 @@
+/*
+  Example: Compile-time typed sensor
+  ----------------------------------
+  When the sensor model is fixed, MyDHTTyped<DHT11> / MyDHTTyped<DHT22> resolves
+  timings, decode formulas and plausible ranges at compile time.
+  Use MyDHT with DHT_AUTO when the model is only known at runtime.
+*/
+
+#include <myDHTPro.h>
+#include <MyDHTTyped.h>
+
+const int DHT_PIN = 2;
+
+// For DHT11
+MyDHTTyped<DHT11> dht(DHT_PIN);
+
+// For DHT22, uncomment the line below and comment out the DHT11 line
+// MyDHTTyped<DHT22> dht(DHT_PIN);
+
+void setup()
+{
+    Serial.begin(115200);
+    dht.begin();
+}
+
+void loop()
+{
+    DHTData data = dht.getData(Celsius);
+
+    if (data.status == DHT_OK)
+    {
+        Serial.print("Temp: ");
+        Serial.print(data.temp);
+        Serial.print(" °C, Hum: ");
+        Serial.print(data.hum);
+        Serial.print(" %, Dew: ");
+        Serial.print(data.dew);
+        Serial.print(" °C, HI: ");
+        Serial.println(data.hi);
+    }
+    else
+    {
+        Serial.print("Error reading sensor: ");
+        Serial.println(data.status);
+    }
+
+    delay(dht.getMinReadInterval()); // Constant for the chosen model
+}
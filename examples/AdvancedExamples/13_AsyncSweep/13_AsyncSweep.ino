@@ -0,0 +1,67 @@
+/*
+  Example: Non-blocking multi-sensor sweep
+  ----------------------------------
+  startSweep() starts an async read on every sensor at once, so their start pulses and
+  transfers overlap. processSweep() must be called from loop(); results arrive through
+  the callback (or poll results[i].ready).
+
+  Sensors on pins with an external interrupt (pins 2 and 3 on Uno/Nano) never block.
+  Other pins fall back to a short (~5 ms) blocking capture.
+*/
+
+#include <myDHTPro.h>
+#include <MultiDHTManager.h>
+
+MyDHT sensor1(2, DHT11);
+MyDHT sensor2(3, DHT22);
+
+// The template argument sizes the sensor table: set it to your own number of sensors
+MultiDHTManager<2> manager;
+DHTResult results[2];
+
+void onResult(const DHTResult &r)
+{
+    Serial.print("Sensor at pin ");
+    Serial.print(r.pin);
+
+    if (r.error == DHT_OK)
+    {
+        Serial.print(": Temp=");
+        Serial.print(r.temperature);
+        Serial.print("°C, RH=");
+        Serial.println(r.humidity);
+    }
+    else
+    {
+        Serial.print(": Error=");
+        Serial.println(r.error);
+    }
+}
+
+void setup()
+{
+    Serial.begin(115200);
+
+    sensor1.begin();
+    sensor2.begin();
+
+    manager.addSensor(sensor1);
+    manager.addSensor(sensor2);
+
+    Serial.println("Async sweep demo started");
+}
+
+void loop()
+{
+    static unsigned long lastSweep = 0;
+
+    if (!manager.isSweeping() && millis() - lastSweep >= 2000)
+    {
+        lastSweep = millis();
+        manager.startSweep(results, onResult);
+    }
+
+    manager.processSweep();
+
+    // Other tasks can run here
+}
@@ -0,0 +1,60 @@
+/*
+  Example: Fixed-point reading
+  ----------------------------------
+  getFixedData() returns temperatures in tenths of a degree and humidity in tenths of %RH.
+  Offsets, unit conversion, dew point and heat index are all computed with integers,
+  so logging and threshold checks never touch float math.
+*/
+
+#include <myDHTPro.h>
+
+MyDHT dht(2, DHT22);
+
+// Prints a value in tenths as "23.5"
+void printDeci(int16_t value)
+{
+    if (value < 0)
+    {
+        Serial.print('-');
+        value = -value;
+    }
+    Serial.print(value / 10);
+    Serial.print('.');
+    Serial.print(value % 10);
+}
+
+void setup()
+{
+    Serial.begin(115200);
+    dht.begin();
+
+    dht.setTemperatureOffsetDeci(-5); // -0.5 °C calibration
+}
+
+void loop()
+{
+    DHTFixedData data = dht.getFixedData(Celsius);
+
+    if (data.status == DHT_OK)
+    {
+        Serial.print("Temp: ");
+        printDeci(data.temp);
+        Serial.print(" °C, RH: ");
+        printDeci(data.hum);
+        Serial.print(" %, Dew point: ");
+        printDeci(data.dew);
+        Serial.print(" °C, Heat index: ");
+        printDeci(data.hi);
+        Serial.println(" °C");
+
+        if (data.temp > 300) // Integer comparison: above 30.0 °C
+            Serial.println("Warm!");
+    }
+    else
+    {
+        Serial.print("Error: ");
+        Serial.println(dht.getErrorString(data.status));
+    }
+
+    delay(2000);
+}
@@ -0,0 +1,85 @@
+/*
+  Example: Batch frame conversion
+  ----------------------------------
+  A gateway receiving raw 5-byte frames from many field nodes can convert them in one call
+  with mydht::convertFrames(). This sketch fills a buffer with synthetic frames,
+  converts them repeatedly and prints the throughput in frames per second.
+*/
+
+#include <myDHTPro.h>
+#include <myDHT_batch.h>
+
+#define FRAME_COUNT 32 // Small enough for the 2 KB of RAM on an Uno
+
+uint8_t frames[FRAME_COUNT][5];
+DHTType types[FRAME_COUNT];
+
+uint8_t valid[FRAME_COUNT];
+float temp[FRAME_COUNT];
+float hum[FRAME_COUNT];
+float dew[FRAME_COUNT];
+float hi[FRAME_COUNT];
+
+// Builds a frame with a correct checksum from humidity and temperature in tenths (DHT22 encoding)
+void makeFrame(uint8_t *frame, uint16_t hum10, int16_t temp10)
+{
+    uint16_t t = (temp10 < 0) ? (uint16_t)(-temp10) | 0x8000 : (uint16_t)temp10;
+    frame[0] = hum10 >> 8;
+    frame[1] = hum10 & 0xFF;
+    frame[2] = t >> 8;
+    frame[3] = t & 0xFF;
+    frame[4] = frame[0] + frame[1] + frame[2] + frame[3];
+}
+
+void setup()
+{
+    Serial.begin(115200);
+
+    for (int i = 0; i < FRAME_COUNT; i++)
+    {
+        makeFrame(frames[i], 400 + i * 10, -50 + i * 12);
+        types[i] = DHT22;
+    }
+    frames[FRAME_COUNT - 1][4] ^= 0x01; // One corrupted frame, reported as invalid
+
+    DHTBatchOutput out = {valid, temp, hum, dew, hi};
+
+    size_t ok = mydht::convertFrames(frames, types, FRAME_COUNT, out, Celsius);
+    Serial.print("Valid frames: ");
+    Serial.print(ok);
+    Serial.print(" / ");
+    Serial.println(FRAME_COUNT);
+
+    Serial.print("Frame 0: ");
+    Serial.print(temp[0], 1);
+    Serial.print(" °C, ");
+    Serial.print(hum[0], 1);
+    Serial.print(" %, dew point ");
+    Serial.print(dew[0], 1);
+    Serial.println(" °C");
+}
+
+void loop()
+{
+    const int rounds = 20;
+    DHTBatchOutput full = {valid, temp, hum, dew, hi};
+    DHTBatchOutput basic = {valid, temp, hum, nullptr, nullptr}; // Skips dew point and heat index
+
+    unsigned long start = micros();
+    for (int r = 0; r < rounds; r++)
+        mydht::convertFrames(frames, types, FRAME_COUNT, full, Celsius);
+    unsigned long fullUs = micros() - start;
+
+    start = micros();
+    for (int r = 0; r < rounds; r++)
+        mydht::convertFrames(frames, types, FRAME_COUNT, basic, Celsius);
+    unsigned long basicUs = micros() - start;
+
+    Serial.print("Full: ");
+    Serial.print(1e6 * rounds * FRAME_COUNT / fullUs, 0);
+    Serial.print(" frames/s, temp + hum only: ");
+    Serial.print(1e6 * rounds * FRAME_COUNT / basicUs, 0);
+    Serial.println(" frames/s");
+
+    delay(5000);
+}
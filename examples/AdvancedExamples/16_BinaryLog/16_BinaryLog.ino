@@ -0,0 +1,75 @@
+/*
+  Example: Compact binary log
+  ----------------------------------
+  DHTLogEncoder writes each reading as a binary record of about 8 bytes (raw frame, time delta,
+  sensor id, status) to any Print. Here the records go to a RAM buffer, as they would before
+  a radio or SD card write, and the sketch prints the bytes per sample and the encode time.
+
+  To log straight to the serial port use DHTLogEncoder logger(Serial); and convert the capture
+  on a PC with the extras/dhtlog tool (binary in, CSV out).
+*/
+
+#include <myDHTPro.h>
+#include <MultiDHTManager.h>
+#include <myDHT_log.h>
+
+// A Print that appends to a fixed byte buffer
+class BufferPrint : public Print
+{
+public:
+    size_t write(uint8_t b) override
+    {
+        if (length >= sizeof(data))
+            return 0;
+        data[length++] = b;
+        return 1;
+    }
+
+    uint8_t data[128];
+    size_t length = 0;
+};
+
+MyDHT sensor1(2, DHT11);
+MyDHT sensor2(3, DHT22);
+
+MultiDHTManager<2> manager; // Room for two sensors
+DHTResult results[2];
+
+BufferPrint buffer;
+DHTLogEncoder logger(buffer);
+
+void setup()
+{
+    Serial.begin(115200);
+    sensor1.begin();
+    sensor2.begin();
+    manager.addSensor(sensor1);
+    manager.addSensor(sensor2);
+}
+
+void loop()
+{
+    manager.readAll(results);
+
+    // Both sensors in one sweep record
+    unsigned long start = micros();
+    size_t bytes = logger.writeSweep(manager, results);
+    unsigned long encodeUs = micros() - start;
+
+    Serial.print("Sweep record: ");
+    Serial.print(bytes);
+    Serial.print(" bytes, encoded in ");
+    Serial.print(encodeUs);
+    Serial.print(" us, average ");
+    Serial.print((float)logger.getBytesWritten() / logger.getSamplesWritten(), 2);
+    Serial.println(" bytes/sample");
+
+    if (buffer.length > sizeof(buffer.data) - 32)
+    {
+        // Send or store buffer.data here, then start over
+        buffer.length = 0;
+        logger.restart(); // A new stream begins with an absolute time record
+    }
+
+    delay(2000);
+}
@@ -0,0 +1,56 @@
+/*
+  Example: Rolling statistics
+  ----------------------------------
+  A DHTHistory attached with setHistory() receives every successful reading and keeps
+  min, max, mean, variance, trend and an EMA of the last N samples up to date.
+  Each query is constant time, so there is no array to rescan in loop().
+*/
+
+#include <myDHTPro.h>
+
+#define READ_INTERVAL_MS 2000
+
+MyDHT dht(2, DHT22);
+DHTHistory<30> history; // Last 30 readings: one minute at 2 s, 12 * 30 bytes of RAM
+
+void setup()
+{
+    Serial.begin(115200);
+    dht.begin();
+    dht.setHistory(&history);
+    history.setEmaAlpha(0.1f);
+}
+
+void loop()
+{
+    if (dht.readSafe() == DHT_OK)
+    {
+        Serial.print("Samples: ");
+        Serial.print(history.getCount());
+
+        Serial.print("  Temp min/mean/max: ");
+        Serial.print(history.getMin(DHT_TEMPERATURE), 1);
+        Serial.print(" / ");
+        Serial.print(history.getMean(DHT_TEMPERATURE), 2);
+        Serial.print(" / ");
+        Serial.print(history.getMax(DHT_TEMPERATURE), 1);
+
+        Serial.print(" °C  std dev: ");
+        Serial.print(sqrt(history.getVariance(DHT_TEMPERATURE)), 2);
+
+        // Trend is per sample; scale it to a rate per minute with the read interval
+        Serial.print("  trend: ");
+        Serial.print(history.getTrend(DHT_TEMPERATURE) * 60000.0f / READ_INTERVAL_MS, 2);
+        Serial.print(" °C/min");
+
+        Serial.print("  Humidity EMA: ");
+        Serial.print(history.getEMA(DHT_HUMIDITY), 1);
+        Serial.println(" %");
+    }
+    else
+    {
+        Serial.println(dht.getErrorString(dht.getLastError()));
+    }
+
+    delay(READ_INTERVAL_MS);
+}
@@ -0,0 +1,54 @@
+/*
+  Example: Non-blocking reads with retry backoff
+  ----------------------------------
+  requestRead() is the non-blocking form of readSafe(): the read starts as soon as the
+  minimum read interval allows it, and failed attempts are retried later instead of
+  waiting with delay(). loop() keeps running at full speed even with a disconnected sensor.
+*/
+
+#include <myDHTPro.h>
+
+MyDHT dht(2, DHT22, 4); // Up to 4 attempts per read
+
+unsigned long loops = 0;
+
+void onReading(DHTData data)
+{
+    if (data.status == DHT_OK)
+    {
+        Serial.print("Temp: ");
+        Serial.print(data.temp, 1);
+        Serial.print(" °C, Hum: ");
+        Serial.print(data.hum, 1);
+        Serial.print(" %");
+    }
+    else
+    {
+        Serial.print("Failed after all attempts: ");
+        Serial.print(dht.getErrorString(data.status));
+    }
+
+    Serial.print("  (loop ran ");
+    Serial.print(loops);
+    Serial.println(" times meanwhile)");
+    loops = 0;
+}
+
+void setup()
+{
+    Serial.begin(115200);
+    dht.begin();
+
+    // Retry 20 ms after the first failure, then 40, 80 ... ms, never more than 500 ms
+    DHTRetryPolicy policy = {20, 2, 500};
+    dht.setRetryPolicy(policy);
+}
+
+void loop()
+{
+    // Queues the next reading; returns false while the previous one is still running
+    dht.requestRead(onReading);
+    dht.processAsync();
+
+    loops++; // Other tasks run here without waiting for the sensor
+}
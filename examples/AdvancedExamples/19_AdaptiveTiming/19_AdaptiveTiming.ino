@@ -0,0 +1,51 @@
+/*
+  Example: Adaptive bit timing
+  ----------------------------------
+  On long cables or slow boards the measured pulse widths drift away from the datasheet values,
+  and bits near the fixed threshold are misread (checksum errors, retries).
+  setAdaptiveTiming(true) learns the real 0-bit and 1-bit widths from every good frame and moves
+  the decode threshold to their midpoint. getTimingStats() shows what has been learned.
+*/
+
+#include <myDHTPro.h>
+
+MyDHT dht(2, DHT22);
+
+void setup()
+{
+    Serial.begin(115200);
+    dht.begin();
+    dht.setAdaptiveTiming(true);
+}
+
+void loop()
+{
+    DHTError err = dht.readSafe();
+
+    if (err == DHT_OK)
+    {
+        Serial.print("Temp: ");
+        Serial.print(dht.getTemperature(), 1);
+        Serial.print(" °C, Hum: ");
+        Serial.print(dht.getHumidity(), 1);
+        Serial.print(" %");
+    }
+    else
+    {
+        Serial.print(dht.getErrorString(err));
+    }
+
+    DHTTimingStats stats = dht.getTimingStats();
+    Serial.print("  | 0-bit: ");
+    Serial.print(stats.zeroHighUs);
+    Serial.print(" us, 1-bit: ");
+    Serial.print(stats.oneHighUs);
+    Serial.print(" us, threshold: ");
+    Serial.print(stats.highThresholdUs);
+    Serial.print(" us, frames: ");
+    Serial.print(stats.learnedFrames);
+    Serial.print(", recovered: ");
+    Serial.println(stats.rescuedFrames);
+
+    delay(2000);
+}
@@ -0,0 +1,69 @@
+/*
+  Example: Read metrics
+  ----------------------------------
+  With DHT_METRICS set to 1 in myDHT_config.h, every sensor counts its reads, attempts, retries
+  and errors per DHTError, the time spent blocking, and keeps log2 histograms of the read latency
+  and of the ACK delay. MultiDHTManager::getMetrics() sums them over all sensors.
+  With DHT_METRICS 0 (default) the metrics are compiled out completely.
+*/
+
+#include <myDHTPro.h>
+
+MyDHT dht(2, DHT22);
+
+#if DHT_METRICS
+// Prints the non-empty buckets of a histogram as "[from µs, to µs): count"
+void printHistogram(const char *name, const uint16_t *histogram)
+{
+    Serial.print(name);
+    for (uint8_t k = 0; k < DHT_METRICS_BUCKETS; k++)
+    {
+        if (!histogram[k])
+            continue;
+        Serial.print("  [");
+        Serial.print(k ? 1UL << (k - 1) : 0UL);
+        Serial.print(", ");
+        Serial.print(1UL << k);
+        Serial.print(") us: ");
+        Serial.print(histogram[k]);
+    }
+    Serial.println();
+}
+#endif
+
+void setup()
+{
+    Serial.begin(115200);
+    dht.begin();
+}
+
+void loop()
+{
+    dht.readSafe();
+
+#if DHT_METRICS
+    DHTMetrics m = dht.getMetrics();
+    Serial.print("Reads: ");
+    Serial.print(m.reads);
+    Serial.print(", OK: ");
+    Serial.print(m.successes);
+    Serial.print(", attempts: ");
+    Serial.print(m.attempts);
+    Serial.print(", retries: ");
+    Serial.print(m.retries);
+    Serial.print(", checksum errors: ");
+    Serial.print(m.errors[DHT_ERROR_CHECKSUM]);
+    Serial.print(", no response: ");
+    Serial.print(m.errors[DHT_ERROR_NO_RESPONSE]);
+    Serial.print(", blocking: ");
+    Serial.print(m.blockingUs / 1000);
+    Serial.println(" ms");
+
+    printHistogram("Latency:", m.latencyUs);
+    printHistogram("ACK:    ", m.ackUs);
+#else
+    Serial.println("Set DHT_METRICS to 1 in myDHT_config.h to enable the metrics");
+#endif
+
+    delay(2000);
+}
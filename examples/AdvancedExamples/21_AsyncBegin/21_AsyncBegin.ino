@@ -0,0 +1,64 @@
+/*
+  Example: Non-blocking startup with type detection
+  ----------------------------------
+  begin() waits 3 s for the sensor to stabilize and, with DHT_AUTO, blocks again for the
+  read that detects the model. beginAsync() runs the same steps from processAsync(), so all
+  sensors start up at the same time and loop() keeps running. Four auto-detected sensors
+  are ready after about 3 s instead of 4 x begin().
+*/
+
+#include <MultiDHTManager.h>
+
+MyDHT sensor1(2); // DHT_AUTO: the model is detected during startup
+MyDHT sensor2(3);
+MyDHT sensor3(4);
+MyDHT sensor4(5);
+
+MultiDHTManager<> manager; // Up to MAX_SENSORS sensors
+bool reported = false;
+
+void setup()
+{
+    Serial.begin(115200);
+
+    manager.addSensor(sensor1);
+    manager.addSensor(sensor2);
+    manager.addSensor(sensor3);
+    manager.addSensor(sensor4);
+
+    manager.beginAsync(); // Returns at once
+}
+
+void loop()
+{
+    // Advances every sensor; true while any of them is still starting up
+    if (manager.processAsync())
+        return;
+
+    if (!reported)
+    {
+        Serial.print("Started after ");
+        Serial.print(millis());
+        Serial.println(" ms");
+
+        for (int i = 0; i < manager.getCount(); i++)
+        {
+            MyDHT *dht = manager.getSensor(i);
+            Serial.print("Pin ");
+            Serial.print(dht->getPin());
+            Serial.print(": ");
+
+            DHTType type = dht->getType();
+            if (type == DHT_AUTO)
+            {
+                Serial.println(dht->getErrorString(dht->getLastError())); // Not detected
+                continue;
+            }
+
+            Serial.print(type == DHT11 ? "DHT11, " : "DHT22, ");
+            Serial.print(dht->getTemperature(), 1); // First reading, taken by the detection
+            Serial.println(" °C");
+        }
+        reported = true;
+    }
+}
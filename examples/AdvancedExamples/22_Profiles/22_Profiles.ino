@@ -0,0 +1,86 @@
+/*
+  Example: Sensor profiles for a warm startup
+  ----------------------------------
+  The first boot detects the sensor type and saves a profile (type, retries, calibration
+  offsets, learned timing) with a CRC. Every later boot restores it: no detection, and the
+  first reading comes after the minimum read interval instead of 3 s + detection.
+  Boards with an EEPROM library use DHTEepromStorage; elsewhere any class with read() and
+  write() works, for example a driver for external flash or FRAM.
+*/
+
+#include <myDHT_storage.h>
+
+#if DHT_EEPROM_STORAGE
+DHTEepromStorage storage;
+#else
+// No EEPROM library on this board: keep the profile in RAM to show the interface
+class RamStorage : public DHTProfileStorage
+{
+public:
+    bool read(uint16_t address, uint8_t *data, uint8_t len) override
+    {
+        if (address + len > sizeof(bytes))
+            return false;
+        memcpy(data, bytes + address, len);
+        return true;
+    }
+
+    bool write(uint16_t address, const uint8_t *data, uint8_t len) override
+    {
+        if (address + len > sizeof(bytes))
+            return false;
+        memcpy(bytes + address, data, len);
+        return true;
+    }
+
+private:
+    uint8_t bytes[DHT_PROFILE_BYTES] = {0};
+};
+RamStorage storage;
+#endif
+
+const uint16_t PROFILE_ADDRESS = 0; // One address per sensor, DHT_PROFILE_BYTES apart
+
+MyDHT dht(2); // DHT_AUTO until a profile says otherwise
+
+void setup()
+{
+    Serial.begin(115200);
+#if defined(ESP8266) || defined(ESP32)
+    EEPROM.begin(64); // Flash-emulated EEPROM needs its size first
+#endif
+
+    unsigned long startMs = millis();
+    bool warm = dht.begin(storage, PROFILE_ADDRESS);
+
+    Serial.print(warm ? "Profile restored: " : "No profile, detected: ");
+    Serial.println(dht.getType() == DHT11 ? "DHT11" : dht.getType() == DHT22 ? "DHT22" : "nothing");
+
+    if (dht.read() == DHT_OK)
+    {
+        Serial.print("First reading after ");
+        Serial.print(millis() - startMs);
+        Serial.print(" ms: ");
+        Serial.print(dht.getTemperature(), 1);
+        Serial.println(" °C");
+    }
+
+    // Calibration is part of the profile: save again after changing it
+    if (!warm)
+    {
+        dht.setTemperatureOffset(-0.5);
+        dht.saveProfile(storage, PROFILE_ADDRESS);
+    }
+}
+
+void loop()
+{
+    delay(dht.getMinReadInterval());
+    if (dht.read() == DHT_OK)
+    {
+        Serial.print(dht.getTemperature(), 1);
+        Serial.print(" °C, ");
+        Serial.print(dht.getHumidity(), 1);
+        Serial.println(" %");
+    }
+}
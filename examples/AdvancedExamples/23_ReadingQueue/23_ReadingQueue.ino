@@ -0,0 +1,79 @@
+/*
+  Example: Reading queue and context callbacks
+  ----------------------------------
+  Three sensors read in the background with requestRead(). Every completed read posts a
+  compact DHTReading (sensor, sequence number, time, values in tenths) to one queue, and
+  loop() handles them in batches whenever it has time. The context callback shows the other
+  option: one handler for all sensors, with a per-sensor label and no global lookups.
+*/
+
+#include <myDHTPro.h>
+
+MyDHT kitchen(2, DHT22);
+MyDHT garage(3, DHT22);
+MyDHT attic(4, DHT11);
+
+MyDHT *sensors[] = {&kitchen, &garage, &attic};
+const char *labels[] = {"Kitchen", "Garage", "Attic"};
+const uint8_t SENSOR_COUNT = 3;
+
+DHTQueue<8> readings;
+
+// Runs from processAsync() as each read completes; context is the sensor's label
+void onRead(MyDHT &sensor, const DHTData &data, void *context)
+{
+    if (data.status != DHT_OK)
+    {
+        Serial.print((const char *)context);
+        Serial.print(": ");
+        Serial.println(sensor.getErrorString(data.status));
+    }
+}
+
+void setup()
+{
+    Serial.begin(115200);
+
+    for (uint8_t i = 0; i < SENSOR_COUNT; i++)
+    {
+        sensors[i]->begin();
+        sensors[i]->setQueue(&readings); // All complete in loop(): one producer
+    }
+}
+
+void loop()
+{
+    for (uint8_t i = 0; i < SENSOR_COUNT; i++)
+    {
+        sensors[i]->requestRead(onRead, (void *)labels[i]); // false while the last read still runs
+        sensors[i]->processAsync();
+    }
+
+    // Batch drain: handle everything that arrived since the last pass
+    DHTReading batch[4];
+    uint8_t n = readings.drain(batch, 4);
+    for (uint8_t k = 0; k < n; k++)
+    {
+        const DHTReading &r = batch[k];
+        if (r.status != DHT_OK)
+            continue; // Already reported by onRead()
+
+        Serial.print("Pin ");
+        Serial.print(r.sensor->getPin());
+        Serial.print(" #");
+        Serial.print(r.seq);
+        Serial.print(" at ");
+        Serial.print(r.timeMs);
+        Serial.print(" ms: ");
+        Serial.print(r.tempC10 / 10.0, 1);
+        Serial.print(" °C, ");
+        Serial.print(r.hum10 / 10.0, 1);
+        Serial.println(" %");
+    }
+
+    if (readings.getDropped())
+    {
+        Serial.print("Dropped so far: ");
+        Serial.println(readings.getDropped());
+    }
+}
@@ -0,0 +1,84 @@
+/*
+  Example: Background sensor service (ESP32)
+  ----------------------------------
+  DHTService reads two sensors on its own FreeRTOS task, pinned to core 0, and publishes
+  every result as a snapshot. loop() on core 1 and a second task fetch the latest values
+  with getLatest() whenever they like: no locks, no waiting for the sensor, and never a
+  temperature from one reading with the humidity of another.
+  Boards without threads (DHT_SERVICE = 0) do not have the service.
+*/
+
+#include <myDHT_service.h>
+
+MyDHT indoor(4, DHT22);
+MyDHT outdoor(5, DHT22);
+
+#if DHT_SERVICE
+DHTService<2> service;
+
+void printReading(const char *who, const DHTReading &r)
+{
+    Serial.print("[");
+    Serial.print(who);
+    Serial.print("] pin ");
+    Serial.print(r.sensor->getPin());
+    Serial.print(" #");
+    Serial.print(r.seq);
+    Serial.print(": ");
+
+    if (r.status == DHT_OK)
+    {
+        Serial.print(r.tempC10 / 10.0, 1);
+        Serial.print(" °C, ");
+        Serial.print(r.hum10 / 10.0, 1);
+        Serial.println(" %");
+    }
+    else
+    {
+        Serial.println(r.sensor->getErrorString((DHTError)r.status));
+    }
+}
+
+// Another consumer, e.g. a display or network task
+void displayTask(void *)
+{
+    for (;;)
+    {
+        DHTReading r;
+        if (service.getLatest(1, r))
+            printReading("display", r);
+        vTaskDelay(pdMS_TO_TICKS(5000));
+    }
+}
+
+void setup()
+{
+    Serial.begin(115200);
+
+    indoor.begin();
+    outdoor.begin();
+    service.add(indoor);
+    service.add(outdoor);
+
+    service.start(10000, 0); // Every 10 s, on core 0
+    xTaskCreatePinnedToCore(displayTask, "display", 4096, nullptr, 1, nullptr, 1);
+}
+
+void loop()
+{
+    DHTReading r;
+    if (service.getLatest(0, r))
+        printReading("loop", r);
+    delay(3000);
+}
+#else
+void setup()
+{
+    Serial.begin(115200);
+    Serial.println("DHTService needs a board with threads (ESP32)");
+}
+
+void loop()
+{
+}
+#endif
@@ -0,0 +1,51 @@
+/*
+  Example: Adaptive sampling rate
+  ----------------------------------
+  Polling at getMinReadInterval() reads a DHT22 every 2 s even when nothing changes.
+  DHTAdaptiveSampler widens the interval while temperature and humidity are flat (up to
+  60 s by default) and tightens it back to 2 s as soon as they move. nextReadDueMs() tells
+  a battery node how long it may sleep; here delay() stands in for the sleep.
+*/
+
+#include <myDHT_sampler.h>
+
+MyDHT dht(2, DHT22);
+DHTAdaptiveSampler sampler(dht);
+
+void setup()
+{
+    Serial.begin(115200);
+    dht.begin();
+
+    // A reading per 0.2 °C or 1 %RH of change, at least one every 2 minutes
+    DHTSamplingPolicy policy = {2, 10, 120000, 2};
+    sampler.setPolicy(policy);
+}
+
+void loop()
+{
+    if (sampler.isDue())
+    {
+        if (sampler.update() == DHT_OK)
+        {
+            Serial.print("Temp: ");
+            Serial.print(dht.getTemperature(), 1);
+            Serial.print(" °C, Hum: ");
+            Serial.print(dht.getHumidity(), 1);
+            Serial.print(" %  next read in ");
+            Serial.print(sampler.getInterval() / 1000.0, 1);
+            Serial.print(" s (");
+            Serial.print(sampler.getReadCount());
+            Serial.println(" reads so far)");
+        }
+        else
+        {
+            Serial.println(dht.getErrorString(dht.getLastError()));
+        }
+    }
+
+    // Sleep until the next read is due (a low-power sleep on a battery node)
+    long waitMs = (long)(sampler.nextReadDueMs() - millis());
+    if (waitMs > 0)
+        delay(waitMs);
+}
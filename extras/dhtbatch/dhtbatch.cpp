@@ -0,0 +1,125 @@
+/*
+  dhtbatch: checks mydht::convertFrames() against MyDHT::makeData() and measures its throughput.
+
+  Usage:  dhtbatch [frames]      (default: 100000)
+
+  Random DHT11 / DHT22 frames (one in three DHT11, every 17th with a broken checksum, some outside
+  the plausible range) are converted in all three units, with and without calibration offsets.
+  Every value must be bit-identical to a test-mode MyDHT of the same type; a mismatch fails the run.
+  Then frames per second, with all columns and with temperature and humidity only.
+
+  The checksum/sanity loop vectorizes at -O2 and above on hosts with SIMD (GCC 12+); compare with
+    make -C extras/host CXXFLAGS=-Os BUILD=build-Os
+  to see the scalar rate.
+
+  Built on a host with the library and the mock Arduino core in extras/host:
+    make -C extras/host && extras/host/build/dhtbatch
+*/
+
+#include "myDHT_batch.h"
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+static bool sameBits(float a, float b)
+{
+    return memcmp(&a, &b, sizeof(float)) == 0;
+}
+
+int main(int argc, char **argv)
+{
+    size_t n = argc > 1 ? strtoul(argv[1], nullptr, 10) : 100000;
+    std::vector<uint8_t> frameBytes(n * 5);
+    uint8_t(*frames)[5] = reinterpret_cast<uint8_t(*)[5]>(frameBytes.data());
+    std::vector<DHTType> types(n);
+    std::vector<uint8_t> valid(n);
+    std::vector<float> temp(n), hum(n), dew(n), hi(n);
+
+    srand(7);
+    for (size_t i = 0; i < n; i++)
+    {
+        uint8_t *b = frames[i];
+        types[i] = (i % 3 == 0) ? DHT11 : DHT22;
+        if (types[i] == DHT11)
+        {
+            b[0] = rand() % 100;
+            b[1] = rand() % 10;
+            b[2] = rand() % 60;
+            b[3] = rand() % 10;
+        }
+        else
+        {
+            int h = rand() % 1010, t = rand() % 1300 - 450;
+            int a = t < 0 ? -t : t;
+            b[0] = h >> 8;
+            b[1] = h;
+            b[2] = (a >> 8) | (t < 0 ? 0x80 : 0);
+            b[3] = a;
+        }
+        b[4] = b[0] + b[1] + b[2] + b[3];
+        if (i % 17 == 0)
+            b[4] ^= 4;
+    }
+
+    DHTBatchOutput out = {valid.data(), temp.data(), hum.data(), dew.data(), hi.data()};
+    size_t validCount = 0;
+    unsigned long mismatches = 0;
+    const float offsets[2] = {0.0f, -0.7f};
+
+    for (int u = 0; u < 3; u++)
+    {
+        for (float off : offsets)
+        {
+            validCount = mydht::convertFrames(frames, types.data(), n, out, (TempUnit)u, off, off * 2);
+            for (size_t i = 0; i < n; i++)
+            {
+                const uint8_t *b = frames[i];
+                MyDHT sensor(2, types[i]);
+                sensor.testMode = true;
+                sensor.setTemperatureOffset(off);
+                sensor.setHumidityOffset(off * 2);
+                sensor.setRawBytes(b[0], b[1], b[2], b[3], b[4]);
+
+                // read() falls back to the last valid data on a sanity failure: count that as invalid
+                bool ok = sensor.read() == DHT_OK && (uint8_t)(b[0] + b[1] + b[2] + b[3]) == b[4];
+                if (ok != (bool)valid[i])
+                {
+                    mismatches++;
+                    continue;
+                }
+                if (!ok)
+                    continue;
+
+                DHTData d = sensor.makeData((TempUnit)u);
+                if (!sameBits(d.temp, temp[i]) || !sameBits(d.hum, hum[i]) || !sameBits(d.dew, dew[i]) ||
+                    !sameBits(d.hi, hi[i]))
+                {
+                    if (mismatches < 5)
+                        printf("mismatch: frame %zu, unit %d, offset %.1f\n", i, u, off);
+                    mismatches++;
+                }
+            }
+        }
+    }
+    printf("%zu of %zu frames valid, %lu mismatches against MyDHT::makeData()\n", validCount, n, mismatches);
+    if (mismatches)
+        return 1;
+
+    const int rounds = 50;
+    DHTBatchOutput lite = {valid.data(), temp.data(), hum.data(), nullptr, nullptr};
+    DHTBatchOutput validOnly = {valid.data(), nullptr, nullptr, nullptr, nullptr};
+    const DHTBatchOutput *cases[3] = {&out, &lite, &validOnly};
+    const char *names[3] = {"all columns", "temperature and humidity", "checks only"};
+
+    for (int c = 0; c < 3; c++)
+    {
+        auto t0 = std::chrono::steady_clock::now();
+        for (int r = 0; r < rounds; r++)
+            mydht::convertFrames(frames, types.data(), n, *cases[c]);
+        double s = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+        printf("  %-26s %6.1f Mframes/s\n", names[c], (double)n * rounds / s / 1e6);
+    }
+    return 0;
+}
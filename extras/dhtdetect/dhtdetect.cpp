@@ -0,0 +1,148 @@
+/*
+  dhtdetect: checks mydht::detectModel() over every frame the two models can send, and times
+  DHT_AUTO start-up on the simulated line.
+
+  Usage:  dhtdetect [randomFrames]      (default: 100000)
+
+  Corpus (byte 4 is not looked at by detectModel(), the checksum is verified before it):
+    DHT22   every humidity 0.0..100.0 % and temperature -40.0..80.0 °C: must be DHT22
+    DHT11   every humidity 5..95 % and temperature 0..50 °C with tenths digits 0-9: must be DHT11
+            inside the DHT11 plausible range, DHT_AUTO (rejected, like sanityCheck()) above it
+    random  bytes 0-3 random: share rejected as fitting neither model
+  Any misdetection fails the run.
+
+  Start-up, virtual time on the simulated line (DHT11 answers start pulses of 18 ms and more):
+    begin() of a DHT11 and of a DHT22 in DHT_AUTO, the model found and the time spent
+    beginAsync() of 8 sensors (DHT11 and DHT22 alternating) through MultiDHTManager, until all are ready
+
+  Built on a host with the library and the mock Arduino core in extras/host:
+    make -C extras/host && extras/host/build/dhtdetect
+*/
+
+#include "Arduino.h"
+#include "MultiDHTManager.h"
+#include "dht_sim.h"
+
+static const char *modelName(DHTType type)
+{
+    return type == DHT11 ? "DHT11" : type == DHT22 ? "DHT22" : "none";
+}
+
+static unsigned long corpus(unsigned long randomFrames)
+{
+    uint8_t b[5] = {0, 0, 0, 0, 0};
+    unsigned long bad = 0;
+
+    unsigned long n22 = 0, bad22 = 0;
+    for (int h = 0; h <= 1000; h++)
+    {
+        for (int t = -400; t <= 800; t++)
+        {
+            int a = t < 0 ? -t : t;
+            b[0] = h >> 8;
+            b[1] = h;
+            b[2] = (a >> 8) | (t < 0 ? 0x80 : 0);
+            b[3] = a;
+            n22++;
+            if (mydht::detectModel(b) != DHT22)
+                bad22++;
+        }
+    }
+    printf("DHT22  %lu frames, %lu misdetected\n", n22, bad22);
+    bad += bad22;
+
+    unsigned long n11 = 0, bad11 = 0, rejected11 = 0;
+    for (int h = 5; h <= 95; h++)
+        for (int hd = 0; hd <= 9; hd++)
+            for (int t = 0; t <= 50; t++)
+                for (int td = 0; td <= 9; td++)
+                {
+                    b[0] = h;
+                    b[1] = hd;
+                    b[2] = t;
+                    b[3] = td;
+                    n11++;
+
+                    bool inRange = t * 10 + td <= DHTModel<DHT11>::maxTempC * 10;
+                    DHTType expected = inRange ? DHT11 : DHT_AUTO;
+                    if (mydht::detectModel(b) != expected)
+                        bad11++;
+                    else if (!inRange)
+                        rejected11++;
+                }
+    printf("DHT11  %lu frames, %lu misdetected (%lu above %.1f °C rejected)\n", n11, bad11, rejected11,
+           (float)DHTModel<DHT11>::maxTempC);
+    bad += bad11;
+
+    unsigned long rejected = 0;
+    srand(1);
+    for (unsigned long i = 0; i < randomFrames; i++)
+    {
+        for (uint8_t k = 0; k < 4; k++)
+            b[k] = rand();
+        if (mydht::detectModel(b) == DHT_AUTO)
+            rejected++;
+    }
+    printf("random %lu frames, %.2f %% rejected\n", randomFrames, randomFrames ? 100.0 * rejected / randomFrames : 0.0);
+    return bad;
+}
+
+static double seconds(uint64_t startNs)
+{
+    return (sim::nowNs - startNs) / 1e9;
+}
+
+static void startup()
+{
+    sim::reset();
+    sim::sensors[2].setDHT11(40, 23);
+    sim::sensors[3].setDHT22(55.5f, 21.3f);
+
+    uint64_t t0 = sim::nowNs;
+    MyDHT dht11(2);
+    dht11.begin();
+    printf("begin() DHT11: %s in %.3f s\n", modelName(dht11.getType()), seconds(t0));
+
+    t0 = sim::nowNs;
+    MyDHT dht22(3);
+    dht22.begin();
+    printf("begin() DHT22: %s in %.3f s\n", modelName(dht22.getType()), seconds(t0));
+
+    const uint8_t count = 8;
+    MyDHT *sensors[count];
+    MultiDHTManager<count> manager;
+    for (uint8_t i = 0; i < count; i++)
+    {
+        uint8_t pin = 4 + i;
+        if (i & 1)
+            sim::sensors[pin].setDHT11(40 + i, 20 + i);
+        else
+            sim::sensors[pin].setDHT22(50.0f + i, 20.5f + i);
+        sensors[i] = new MyDHT(pin);
+        manager.addSensor(*sensors[i]);
+    }
+
+    t0 = sim::nowNs;
+    manager.beginAsync();
+    while (manager.processAsync())
+        sim::advanceNs(100000);
+
+    unsigned long ok = 0;
+    for (uint8_t i = 0; i < count; i++)
+    {
+        DHTType expected = (i & 1) ? DHT11 : DHT22;
+        ok += sensors[i]->getType() == expected && sensors[i]->getLastError() == DHT_OK;
+    }
+    printf("beginAsync() x%u: %lu detected and read in %.3f s\n", count, ok, seconds(t0));
+
+    for (uint8_t i = 0; i < count; i++)
+        delete sensors[i];
+}
+
+int main(int argc, char **argv)
+{
+    unsigned long randomFrames = argc > 1 ? strtoul(argv[1], nullptr, 10) : 100000;
+    unsigned long bad = corpus(randomFrames);
+    startup();
+    return bad ? 1 : 0;
+}
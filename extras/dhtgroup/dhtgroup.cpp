@@ -0,0 +1,172 @@
+/*
+  dhtgroup: prototype bit-sliced group decoder, benchmarked against the per-sensor decode that
+  MultiDHTManager group reads use (mydht::decodeFrame() + mydht::checksumOk()).
+
+  Usage:  dhtgroup [rounds]      (default: 200000 decodes of each group size)
+
+  Group captures store one array of HIGH durations per line, so the sliced decoder:
+    1. classifies each of the 40 HIGH durations of every line into a bit plane (bit k = line k)
+    2. sums bytes 0-3 plane by plane with a ripple-carry adder and compares with byte 4
+    3. unpacks only the lines whose checksum matched
+  Random frames, every fifth one with a broken checksum, thresholds 48 / 50 us alternating.
+  Both decoders are checked bit-exact against each other before timing; a mismatch fails the run.
+
+  Built on a host with the library and the mock Arduino core in extras/host:
+    make -C extras/host && extras/host/build/dhtgroup
+*/
+
+#include "myDHT_protocol.h"
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*
+  Bit-sliced decode of up to sizeof(Lanes) * 8 lines.
+  @param thresholdsUs HIGH threshold of each line (lines may be different models)
+  @param bytes        Out: 5 bytes per line, written only for lines in the returned mask
+  @return Mask of lines with a valid checksum
+*/
+template <class Lanes>
+Lanes decodeGroup(uint8_t *const *highTimes, const uint8_t *thresholdsUs, uint8_t n, uint8_t *const *bytes)
+{
+    Lanes planes[40]; // planes[i]: bit i of the frame (MSB first) for every line
+
+    for (uint8_t i = 0; i < 40; i++)
+    {
+        Lanes plane = 0;
+        for (uint8_t k = 0; k < n; k++)
+            plane |= (Lanes)(highTimes[k][i] > thresholdsUs[k]) << k;
+        planes[i] = plane;
+    }
+
+    // Sum of bytes 0-3, sum[w] holding weight 2^w (bit w of byte b is planes[b * 8 + 7 - w])
+    Lanes sum[8];
+    for (uint8_t w = 0; w < 8; w++)
+        sum[w] = planes[7 - w];
+
+    for (uint8_t b = 1; b < 4; b++)
+    {
+        Lanes carry = 0;
+        for (uint8_t w = 0; w < 8; w++)
+        {
+            Lanes x = planes[b * 8 + 7 - w];
+            Lanes half = sum[w] ^ x;
+            Lanes nextCarry = (sum[w] & x) | (carry & half);
+            sum[w] = half ^ carry;
+            carry = nextCarry; // Carry out of 2^7 is the mod-256 overflow, dropped
+        }
+    }
+
+    Lanes mismatch = 0;
+    for (uint8_t w = 0; w < 8; w++)
+        mismatch |= sum[w] ^ planes[32 + 7 - w];
+
+    Lanes all = (n >= sizeof(Lanes) * 8) ? (Lanes)~(Lanes)0 : (Lanes)(((Lanes)1 << n) - 1);
+    Lanes ok = ~mismatch & all;
+
+    for (uint8_t k = 0; k < n; k++)
+    {
+        if (!((ok >> k) & 1))
+            continue;
+        for (uint8_t b = 0; b < 5; b++)
+        {
+            uint8_t value = 0;
+            for (uint8_t j = 0; j < 8; j++)
+                value = (value << 1) | ((planes[b * 8 + j] >> k) & 1);
+            bytes[k][b] = value;
+        }
+    }
+    return ok;
+}
+
+static const uint8_t MAX_LINES = 32;
+
+static uint8_t highTimes[MAX_LINES][40];
+static uint8_t thresholds[MAX_LINES];
+static uint8_t out[MAX_LINES][5];
+static uint8_t ref[MAX_LINES][5];
+
+static double secondsSince(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Per-sensor path of MultiDHTManager::readGroup(): decode, then checksum
+static uint32_t decodeScalar(uint8_t *const *hp, uint8_t n, uint8_t *const *op)
+{
+    uint32_t ok = 0;
+    for (uint8_t k = 0; k < n; k++)
+    {
+        DHTTimings t = {0, 0, 0, 0, thresholds[k]};
+        mydht::decodeFrame(t, hp[k], op[k]);
+        ok |= (uint32_t)mydht::checksumOk(op[k]) << k;
+    }
+    return ok;
+}
+
+static uint32_t decodeSliced(uint8_t *const *hp, uint8_t n, uint8_t *const *op)
+{
+    return (n <= 8) ? decodeGroup<uint8_t>(hp, thresholds, n, op) : decodeGroup<uint32_t>(hp, thresholds, n, op);
+}
+
+int main(int argc, char **argv)
+{
+    long rounds = argc > 1 ? atol(argv[1]) : 200000;
+    const uint8_t sizes[] = {1, 2, 4, 8, 16, 32};
+    uint8_t *hp[MAX_LINES], *op[MAX_LINES], *rp[MAX_LINES];
+    volatile uint32_t sink = 0;
+    srand(1);
+
+    printf("lines   scalar ns/sensor   sliced ns/sensor\n");
+    for (uint8_t n : sizes)
+    {
+        for (uint8_t k = 0; k < n; k++)
+        {
+            hp[k] = highTimes[k];
+            op[k] = out[k];
+            rp[k] = ref[k];
+            thresholds[k] = (k & 1) ? 50 : 48;
+
+            uint8_t f[5];
+            for (uint8_t b = 0; b < 4; b++)
+                f[b] = rand();
+            f[4] = f[0] + f[1] + f[2] + f[3];
+            if (k % 5 == 3)
+                f[4] ^= 1;
+            for (uint8_t i = 0; i < 40; i++)
+                highTimes[k][i] = ((f[i / 8] >> (7 - i % 8)) & 1) ? 70 + rand() % 8 : 24 + rand() % 8;
+        }
+
+        uint32_t okScalar = decodeScalar(hp, n, rp);
+        uint32_t okSliced = decodeSliced(hp, n, op);
+        for (uint8_t k = 0; k < n; k++)
+        {
+            if (okScalar != okSliced || (((okScalar >> k) & 1) && memcmp(ref[k], out[k], 5)))
+            {
+                printf("mismatch at %u lines, line %u\n", n, k);
+                return 1;
+            }
+        }
+
+        // Flipping one width every round keeps the compiler from hoisting the decode
+        auto t0 = std::chrono::steady_clock::now();
+        for (long r = 0; r < rounds; r++)
+        {
+            sink += decodeScalar(hp, n, op);
+            highTimes[0][0] ^= (r & 1);
+        }
+        double scalarS = secondsSince(t0);
+
+        t0 = std::chrono::steady_clock::now();
+        for (long r = 0; r < rounds; r++)
+        {
+            sink += decodeSliced(hp, n, op);
+            highTimes[0][0] ^= (r & 1);
+        }
+        double slicedS = secondsSince(t0);
+
+        printf("%5u   %16.1f   %16.1f\n", n, scalarS / rounds / n * 1e9, slicedS / rounds / n * 1e9);
+    }
+    return 0;
+}
@@ -0,0 +1,141 @@
+/*
+  dhtgroupread: checks MultiDHTManager group reads (setGroupRead(true)) on the simulated lines.
+
+  Usage:  dhtgroupread [rounds] [maxJitterNs]      (default: 500 rounds, 8000 ns)
+
+  For 4 to 8 lines on one port (pins 8-15), DHT22 and DHT11 alternating, each line with its own
+  pulse jitter (up to +-maxJitterNs, a different amount per line, drawn per pulse). Two cases per
+  line count: every line answers, and the last line has no sensor. Every round gives each sensor
+  a new random reading and calls readAll(), once serial and once in group mode. Errors:
+    answering line   result not DHT_OK, or values not the ones the sensor sent
+    missing line     result not DHT_ERROR_NO_RESPONSE
+  Any error fails the run. Also prints the virtual time of one readAll() in each mode.
+
+  Group reads need the register pin backend, which the mock core provides with port registers:
+    make -C extras/host PORTS=1 BUILD=build-ports && extras/host/build-ports/dhtgroupread
+  In the default host build (digitalRead() pins) group mode falls back to serial reads.
+*/
+
+#include "Arduino.h"
+#include "MultiDHTManager.h"
+#include "dht_sim.h"
+#include "myDHT_pin.h"
+#include <math.h>
+
+static const uint8_t FIRST_PIN = 8; // Port 1 of the mock core
+static const uint8_t MAX_LINES = 8;
+
+struct Expected
+{
+    int16_t tempC10;
+    uint16_t hum10;
+};
+
+// New random reading for one line, inside the model's range
+static Expected randomReading(sim::Sensor &line, DHTType type)
+{
+    Expected e;
+    if (type == DHT11)
+    {
+        e.hum10 = (20 + rand() % 71) * 10;
+        e.tempC10 = (rand() % 51) * 10;
+        line.setDHT11(e.hum10 / 10, e.tempC10 / 10);
+    }
+    else
+    {
+        e.hum10 = rand() % 1001;
+        e.tempC10 = rand() % 1201 - 400;
+        line.setDHT22(e.hum10 / 10.0f, e.tempC10 / 10.0f);
+    }
+    return e;
+}
+
+struct Outcome
+{
+    unsigned long errors = 0;
+    double msPerRead = 0;
+};
+
+static Outcome run(uint8_t lines, bool missing, bool group, unsigned long rounds, uint32_t maxJitterNs)
+{
+    sim::reset();
+    srand(lines * 2 + missing);
+
+    MultiDHTManager<MAX_LINES> manager;
+    MyDHT *sensors[MAX_LINES];
+    DHTType types[MAX_LINES];
+    for (uint8_t k = 0; k < lines; k++)
+    {
+        uint8_t pin = FIRST_PIN + k;
+        types[k] = (k & 1) ? DHT11 : DHT22;
+        sim::sensors[pin].jitterNs = maxJitterNs * (1 + (k * 5) % MAX_LINES) / MAX_LINES;
+        sensors[k] = new MyDHT(pin, types[k]);
+        sensors[k]->begin();
+        manager.addSensor(*sensors[k]);
+    }
+    if (missing)
+        sim::sensors[FIRST_PIN + lines - 1].present = false;
+    manager.setGroupRead(group);
+
+    Outcome out;
+    uint64_t readNs = 0;
+    DHTResult results[MAX_LINES];
+    Expected expected[MAX_LINES];
+    for (unsigned long r = 0; r < rounds; r++)
+    {
+        for (uint8_t k = 0; k < lines; k++)
+            expected[k] = randomReading(sim::sensors[FIRST_PIN + k], types[k]);
+        sim::advanceNs(2100000000ull); // Past the minimum interval of both models
+
+        uint64_t t0 = sim::nowNs;
+        manager.readAll(results);
+        readNs += sim::nowNs - t0;
+
+        for (uint8_t k = 0; k < lines; k++)
+        {
+            const DHTResult &res = results[k];
+            bool ok;
+            if (!sim::sensors[FIRST_PIN + k].present)
+                ok = res.error == DHT_ERROR_NO_RESPONSE;
+            else
+                ok = res.error == DHT_OK && fabsf(res.temperature - expected[k].tempC10 / 10.0f) < 0.01f &&
+                     fabsf(res.humidity - expected[k].hum10 / 10.0f) < 0.01f;
+            out.errors += !ok;
+        }
+    }
+
+    for (uint8_t k = 0; k < lines; k++)
+        delete sensors[k];
+    out.msPerRead = readNs / 1e6 / rounds;
+    return out;
+}
+
+int main(int argc, char **argv)
+{
+    unsigned long rounds = argc > 1 ? strtoul(argv[1], nullptr, 10) : 500;
+    uint32_t maxJitterNs = argc > 2 ? strtoul(argv[2], nullptr, 10) : 8000;
+
+#if defined(DHT_PIN_REGISTER_BACKEND)
+    printf("pin backend: port registers, group reads enabled\n");
+#else
+    printf("pin backend: digitalRead(), group mode falls back to serial reads (build with PORTS=1)\n");
+#endif
+    printf("%lu rounds, jitter up to +-%u ns per line, virtual ms per readAll()\n", rounds, maxJitterNs);
+    printf("  lines  missing   serial errors      ms   group errors      ms\n");
+
+    unsigned long errors = 0;
+    for (uint8_t lines = 4; lines <= MAX_LINES; lines++)
+    {
+        for (int missing = 0; missing < 2; missing++)
+        {
+            Outcome serial = run(lines, missing, false, rounds, maxJitterNs);
+            Outcome group = run(lines, missing, true, rounds, maxJitterNs);
+            errors += serial.errors + group.errors;
+            printf("  %5u  %7s  %13lu  %6.1f  %13lu  %6.1f\n", lines, missing ? "1" : "-", serial.errors,
+                   serial.msPerRead, group.errors, group.msPerRead);
+        }
+    }
+
+    printf("%s\n", errors ? "FAILED" : "all rounds ok");
+    return errors ? 1 : 0;
+}
@@ -0,0 +1,161 @@
+/*
+  dhthistory: checks DHTHistory against a brute-force rescan of the window and measures add().
+
+  Usage:  dhthistory [samples] [maxN]      (default: 20000 samples for every N = 1..300)
+
+  For each window size N, random samples (temperature -40.0..80.0 °C, humidity 0..100 %, the window
+  cleared every 1000 samples) go into a DHTHistory and into a plain deque. After every add() all
+  statistics of both channels are compared with a rescan of the deque:
+    min / max / samples   exact
+    mean / variance       relative error up to 1e-4 (variance relative to max(1, variance))
+    trend                 absolute error up to 1e-4 per sample
+    EMA                   absolute error up to 0.005 against the recurrence in double precision
+                          (the history keeps it in fixed point, alpha in steps of 1/256)
+  Any difference fails the run. Then ns per add() for N = 8, 64, 512 and 4096.
+
+  Built on a host with the library and the mock Arduino core in extras/host:
+    make -C extras/host && extras/host/build/dhthistory
+*/
+
+#include "myDHT_history.h"
+#include <chrono>
+#include <deque>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+// Window with its storage sized at run time, so one binary covers every N
+class Window : public DHTHistoryBase
+{
+public:
+    explicit Window(uint16_t n) : Window(n, new int16_t[2 * n], new uint16_t[4 * n]) {}
+    ~Window()
+    {
+        delete[] _values;
+        delete[] _deques;
+    }
+
+private:
+    Window(uint16_t n, int16_t *values, uint16_t *deques)
+        : DHTHistoryBase(values, deques, n), _values(values), _deques(deques) {}
+
+    int16_t *_values;
+    uint16_t *_deques;
+};
+
+struct Worst
+{
+    double mean = 0, variance = 0, trend = 0, ema = 0;
+};
+
+// Compares one channel with a rescan; returns the number of exact mismatches
+static unsigned long compare(const Window &h, DHTChannel ch, const std::deque<int> &q, double ema, Worst &worst)
+{
+    unsigned long bad = 0;
+    int n = q.size();
+    int mn = q[0], mx = q[0];
+    double s = 0, ss = 0, sxy = 0;
+    for (int k = 0; k < n; k++)
+    {
+        mn = q[k] < mn ? q[k] : mn;
+        mx = q[k] > mx ? q[k] : mx;
+        s += q[k];
+        ss += (double)q[k] * q[k];
+        sxy += (double)k * q[k];
+    }
+
+    if (h.getMin(ch) != mn / 10.0f || h.getMax(ch) != mx / 10.0f)
+        bad++;
+    if (h.getSample(ch, 0) != q.back() || h.getSample(ch, n - 1) != q.front())
+        bad++;
+
+    double mean = s / n / 10;
+    double var = (ss / n - (s / n) * (s / n)) / 100;
+    worst.mean = fmax(worst.mean, fabs(h.getMean(ch) - mean) / fmax(1, fabs(mean)));
+    worst.variance = fmax(worst.variance, fabs(h.getVariance(ch) - var) / fmax(1, var));
+    worst.ema = fmax(worst.ema, fabs(h.getEMA(ch) - ema));
+    if (n > 1)
+    {
+        double sx = n * (n - 1) / 2.0, sxx = (n - 1.0) * n * (2 * n - 1) / 6;
+        double slope = (n * sxy - sx * s) / (n * sxx - sx * sx) / 10;
+        worst.trend = fmax(worst.trend, fabs(h.getTrend(ch) - slope));
+    }
+    else if (h.getTrend(ch) != 0)
+        bad++;
+    return bad;
+}
+
+static unsigned long check(uint16_t n, unsigned long samples, Worst &worst)
+{
+    Window h(n);
+    std::deque<int> q[2];
+    double ema[2] = {0, 0};
+    const double alpha = 51 / 256.0; // DHTHistoryBase default 0.2, in steps of 1/256
+    unsigned long bad = 0;
+
+    for (unsigned long i = 0; i < samples; i++)
+    {
+        if (i % 1000 == 0)
+        {
+            h.clear();
+            q[0].clear();
+            q[1].clear();
+        }
+        int v[2] = {rand() % 1201 - 400, rand() % 1001};
+        h.add(v[0], v[1]);
+
+        for (int ch = 0; ch < 2; ch++)
+        {
+            // The EMA starts at the first sample after clear()
+            double x = v[ch] / 10.0;
+            ema[ch] = q[ch].empty() ? x : ema[ch] + alpha * (x - ema[ch]);
+            q[ch].push_back(v[ch]);
+            if (q[ch].size() > n)
+                q[ch].pop_front();
+            bad += compare(h, (DHTChannel)ch, q[ch], ema[ch], worst);
+        }
+    }
+    return bad;
+}
+
+static double nsPerAdd(uint16_t n)
+{
+    Window h(n);
+    int16_t v[1024];
+    for (int i = 0; i < 1024; i++)
+        v[i] = rand() % 1201 - 400;
+
+    const long updates = 5000000;
+    auto t0 = std::chrono::steady_clock::now();
+    for (long i = 0; i < updates; i++)
+        h.add(v[i & 1023], 500 + (v[(i + 7) & 1023] >> 2));
+    double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - t0).count() / updates;
+
+    volatile float sink = h.getMean(DHT_TEMPERATURE); // Keeps the loop
+    (void)sink;
+    return ns;
+}
+
+int main(int argc, char **argv)
+{
+    unsigned long samples = argc > 1 ? strtoul(argv[1], nullptr, 10) : 20000;
+    uint16_t maxN = argc > 2 ? atoi(argv[2]) : 300;
+    srand(3);
+
+    Worst worst;
+    unsigned long bad = 0;
+    for (uint16_t n = 1; n <= maxN; n++)
+        bad += check(n, samples, worst);
+
+    printf("N = 1..%u, %lu samples each: %lu mismatches\n", maxN, samples, bad);
+    printf("  worst error: mean %.2g (relative)  variance %.2g (relative)  trend %.2g  EMA %.2g\n", worst.mean,
+           worst.variance, worst.trend, worst.ema);
+    if (bad || worst.mean > 1e-4 || worst.variance > 1e-4 || worst.trend > 1e-4 || worst.ema > 0.005)
+        return 1;
+
+    printf("ns per add() on this host\n");
+    const uint16_t sizes[] = {8, 64, 512, 4096};
+    for (uint16_t n : sizes)
+        printf("  N = %4u   %.1f\n", n, nsPerAdd(n));
+    return 0;
+}
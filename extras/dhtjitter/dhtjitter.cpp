@@ -0,0 +1,100 @@
+/*
+  dhtjitter: error rate of the blocking bit reader under pulse jitter and slow API calls.
+
+  Usage:  dhtjitter [jitterNs] [microsCostNs] [readCostNs] [reads] [skewNs]
+          (default: 8000 ns jitter, AVR-like 3500 / 3000 ns call costs, 2000 reads per model, no skew)
+
+  Every read gets a random, valid frame from the simulated sensor, with every pulse length varied
+  by up to +-jitterNs and skewNs moved from each bit LOW to the HIGH after it (sim::Sensor::highSkewNs,
+  as a slow-rising line on a long cable). A single attempt per read (setRetries(1)), so each failure
+  shows up. Prints per model, with fixed and with adaptive bit timing (setAdaptiveTiming(true)), the
+  outcome counts and the micros() / digitalRead() calls spent per read; adaptive rows add the
+  threshold learned and the frames rescued by the per-frame re-decode.
+
+  Slow MCU case from the capture/decode split:  dhtjitter 8000 8000 6000
+  Stretched HIGH pulses, fixed against adaptive timing:  dhtjitter 8000 3500 3000 300 20000
+
+  Built on a host with the library and the mock Arduino core in extras/host:
+    make -C extras/host && extras/host/build/dhtjitter
+  To compare with another revision of the driver, build it against that src/ tree:
+    make -C extras/host SRC=/path/to/old/src BUILD=build-old
+*/
+
+#include "Arduino.h"
+#include "dht_sim.h"
+#include "myDHTPro.h"
+
+static const uint8_t PIN = 2;
+
+// Random frame inside the model's range, checksum included
+static void randomFrame(sim::Sensor &line, DHTType type)
+{
+    if (type == DHT11)
+        line.setBytes(rand() % 90, 0, rand() % 50, 0);
+    else
+        line.setBytes(rand() & 1, rand(), rand() % 3, rand());
+}
+
+static void run(DHTType type, bool adaptive, unsigned long reads)
+{
+    sim::Sensor &line = sim::sensors[PIN];
+    MyDHT sensor(PIN, type);
+    sensor.begin();
+    sensor.setRetries(1);
+    sensor.setAdaptiveTiming(adaptive);
+
+    unsigned long ok = 0, bitTimeout = 0, checksum = 0, other = 0;
+    sim::microsCalls = sim::readCalls = 0;
+
+    for (unsigned long i = 0; i < reads; i++)
+    {
+        randomFrame(line, type);
+        sim::advanceNs(2000000000ull);
+
+        DHTError err = sensor.read();
+        if (err == DHT_OK || err == DHT_ERROR_SANITY) // Frame decoded; random values may be implausible
+            ok++;
+        else if (err == DHT_ERROR_BIT_TIMEOUT)
+            bitTimeout++;
+        else if (err == DHT_ERROR_CHECKSUM)
+            checksum++;
+        else
+            other++;
+    }
+
+    printf("%s %-8s: ok %lu  bit timeout %lu  checksum %lu  other %lu   (%lu micros(), %lu digitalRead() per read)",
+           type == DHT22 ? "DHT22" : "DHT11", adaptive ? "adaptive" : "fixed", ok, bitTimeout, checksum, other,
+           sim::microsCalls / reads, sim::readCalls / reads);
+    if (adaptive)
+    {
+        DHTTimingStats stats = sensor.getTimingStats();
+        printf("  threshold %u us, %u rescued", stats.highThresholdUs, stats.rescuedFrames);
+    }
+    printf("\n");
+}
+
+int main(int argc, char **argv)
+{
+    sim::reset();
+    uint32_t jitterNs = argc > 1 ? strtoul(argv[1], nullptr, 10) : 8000;
+    sim::microsCostNs = argc > 2 ? strtoul(argv[2], nullptr, 10) : 3500;
+    sim::readCostNs = argc > 3 ? strtoul(argv[3], nullptr, 10) : 3000;
+    unsigned long reads = argc > 4 ? strtoul(argv[4], nullptr, 10) : 2000;
+    int32_t skewNs = argc > 5 ? strtol(argv[5], nullptr, 10) : 0;
+
+    sim::sensors[PIN].jitterNs = jitterNs;
+    sim::sensors[PIN].highSkewNs = skewNs;
+
+    printf("jitter +-%u ns, HIGH skew %d ns, micros() %u ns, digitalRead() %u ns, %lu reads per model\n", jitterNs,
+           skewNs, sim::microsCostNs, sim::readCostNs, reads);
+    const DHTType types[] = {DHT22, DHT11};
+    for (DHTType type : types)
+    {
+        for (int adaptive = 0; adaptive < 2; adaptive++)
+        {
+            srand(42); // Same frames and jitter for both timing modes
+            run(type, adaptive, reads);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,339 @@
+/*
+  dhtlog: converts a binary myDHT log (DHTLogEncoder) to CSV.
+
+  Usage:  dhtlog [-f | -k] [log.bin]     (reads stdin without a file; -f / -k: °F / K)
+          dhtlog --bench [samples]       (round trip and encode throughput, default 20000 samples)
+
+  Built on a host with the library and the mock Arduino core in extras/host:
+    make -C extras/host && extras/host/build/dhtlog
+
+  Output columns: time_ms, sensor id, sweep index, type, status, temp, hum, dew, hi, raw frame.
+  A summary with the bytes per sample goes to stderr.
+
+  --bench: 8 test-mode sensors (DHT22 and DHT11 alternating, calibration offsets on the odd ones)
+  get random frames (some outside the plausible range) and are logged as single samples and as
+  sweeps of a MultiDHTManager, into memory; some single samples are logged as checksum failures
+  or timeouts instead.
+  The log is decoded back in ragged chunks of 1 to 7 bytes: every record must match what was
+  written, and toData() must be bit-identical to MyDHT::makeData() in all three units. Any
+  difference fails the run. Then the encode rate into a Print that drops the bytes.
+*/
+
+#include "dht_sim.h"
+#include "myDHT_log.h"
+#include <algorithm>
+#include <chrono>
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+
+static const char *typeName(DHTType type) { return type == DHT11 ? "DHT11" : "DHT22"; }
+
+// Keeps the log in memory
+class BufferPrint : public Print
+{
+public:
+    std::vector<uint8_t> data;
+
+    size_t write(uint8_t c) override
+    {
+        data.push_back(c);
+        return 1;
+    }
+    size_t write(const uint8_t *buf, size_t len) override
+    {
+        data.insert(data.end(), buf, buf + len);
+        return len;
+    }
+};
+
+// Drops the log: only the encoder is timed
+class NullPrint : public Print
+{
+public:
+    size_t write(uint8_t) override { return 1; }
+    size_t write(const uint8_t *, size_t len) override { return len; }
+};
+
+static const uint8_t BENCH_SENSORS = 8;
+static const float BENCH_TEMP_OFFSET = -0.7f; // Odd sensors
+static const float BENCH_HUM_OFFSET = 1.4f;
+
+// One logged sample as written, with the sensor's own conversion in every unit
+struct Written
+{
+    unsigned long timeMs;
+    uint8_t id;
+    DHTType type;
+    DHTError status;
+    bool hasFrame;
+    uint8_t bytes[5];
+    uint8_t sweepIndex, sweepSize;
+    DHTData data[3];
+};
+
+static bool sameBits(float a, float b)
+{
+    return memcmp(&a, &b, sizeof(float)) == 0;
+}
+
+// Random frame for the model, some outside the plausible range
+static void randomFrame(MyDHT &sensor)
+{
+    uint8_t b[5];
+    if (sensor.getType() == DHT11)
+    {
+        b[0] = rand() % 100;
+        b[1] = rand() % 10;
+        b[2] = rand() % 60;
+        b[3] = rand() % 10;
+    }
+    else
+    {
+        int h = rand() % 1010, t = rand() % 1300 - 450;
+        int a = t < 0 ? -t : t;
+        b[0] = h >> 8;
+        b[1] = h;
+        b[2] = (a >> 8) | (t < 0 ? 0x80 : 0);
+        b[3] = a;
+    }
+    b[4] = b[0] + b[1] + b[2] + b[3];
+    sensor.setRawBytes(b[0], b[1], b[2], b[3], b[4]);
+    sensor.read();
+}
+
+static Written written(uint8_t id, MyDHT &sensor, unsigned long ms, uint8_t sweepIndex, uint8_t sweepSize)
+{
+    Written w;
+    w.timeMs = ms;
+    w.id = id;
+    w.type = sensor.getType();
+    w.status = sensor.getLastError();
+    w.hasFrame = w.status == DHT_OK || w.status == DHT_ERROR_CHECKSUM || w.status == DHT_ERROR_SANITY;
+    memcpy(w.bytes, sensor.getRawView().bytes, 5);
+    w.sweepIndex = sweepIndex;
+    w.sweepSize = sweepSize;
+    for (int u = 0; u < 3; u++)
+        w.data[u] = sensor.makeData((TempUnit)u);
+    return w;
+}
+
+static bool matches(const DHTLogRecord &rec, const Written &w)
+{
+    if (rec.timeMs != w.timeMs || rec.id != w.id || rec.type != w.type || rec.status != w.status ||
+        rec.hasFrame != w.hasFrame || rec.sweepIndex != w.sweepIndex || rec.sweepSize != w.sweepSize)
+        return false;
+    if (w.hasFrame && memcmp(rec.bytes, w.bytes, 5))
+        return false;
+    if (w.status != DHT_OK)
+        return true;
+
+    float tOff = (w.id & 1) ? BENCH_TEMP_OFFSET : 0.0f, hOff = (w.id & 1) ? BENCH_HUM_OFFSET : 0.0f;
+    for (int u = 0; u < 3; u++)
+    {
+        DHTData d = DHTLogDecoder::toData(rec, (TempUnit)u, tOff, hOff);
+        const DHTData &e = w.data[u];
+        if (!sameBits(d.temp, e.temp) || !sameBits(d.hum, e.hum) || !sameBits(d.dew, e.dew) || !sameBits(d.hi, e.hi))
+            return false;
+    }
+    return true;
+}
+
+static int bench(unsigned long samples)
+{
+    sim::reset();
+    sim::microsCostNs = 0; // millis() in writeSweep() must not move the clock
+    srand(11);
+
+    MyDHT *sensors[BENCH_SENSORS];
+    MultiDHTManager<BENCH_SENSORS> manager;
+    for (uint8_t k = 0; k < BENCH_SENSORS; k++)
+    {
+        sensors[k] = new MyDHT(2 + k, (k & 1) ? DHT11 : DHT22);
+        sensors[k]->testMode = true;
+        if (k & 1)
+        {
+            sensors[k]->setTemperatureOffset(BENCH_TEMP_OFFSET);
+            sensors[k]->setHumidityOffset(BENCH_HUM_OFFSET);
+        }
+        manager.addSensor(*sensors[k]);
+    }
+
+    // Log: single samples, one in four records a sweep of the sensors marked ready
+    BufferPrint log;
+    DHTLogEncoder encoder(log);
+    std::vector<Written> ref;
+    DHTResult results[BENCH_SENSORS];
+    unsigned long sweeps = 0;
+    for (unsigned long i = 0; ref.size() < samples; i++)
+    {
+        sim::advanceNs((1000 + rand() % 3000) * 1000000ull);
+        unsigned long ms = millis();
+
+        if (rand() % 4)
+        {
+            uint8_t id = rand() % BENCH_SENSORS;
+            MyDHT &s = *sensors[id];
+            randomFrame(s);
+            if (rand() % 20 == 0)
+            {
+                encoder.writeSample(id, s.getType(), DHT_ERROR_TIMEOUT, nullptr, ms); // No frame
+                Written w = {ms, id, s.getType(), DHT_ERROR_TIMEOUT, false, {0}, 0, 0, {}};
+                ref.push_back(w);
+                continue;
+            }
+            if (i % 17 == 0)
+            {
+                // Test mode does not verify checksums: log a broken frame directly, all 5 bytes kept
+                Written w = written(id, s, ms, 0, 0);
+                w.status = DHT_ERROR_CHECKSUM;
+                w.bytes[4] ^= 4;
+                encoder.writeSample(id, w.type, w.status, w.bytes, ms);
+                ref.push_back(w);
+                continue;
+            }
+            encoder.writeSample(id, s.getType(), s.getLastError(), s.getRawView().bytes, ms);
+            ref.push_back(written(id, s, ms, 0, 0));
+            continue;
+        }
+
+        uint8_t entries = 0;
+        for (uint8_t k = 0; k < BENCH_SENSORS; k++)
+        {
+            results[k].ready = rand() % 4 != 0;
+            entries += results[k].ready;
+            randomFrame(*sensors[k]);
+            results[k].error = sensors[k]->getLastError();
+        }
+        encoder.writeSweep(manager, results);
+        sweeps++;
+        uint8_t index = 0;
+        for (uint8_t k = 0; k < BENCH_SENSORS; k++)
+            if (results[k].ready)
+                ref.push_back(written(k, *sensors[k], ms, index++, entries));
+    }
+
+    // Decode, offering the stream a few bytes more at a time
+    DHTLogDecoder decoder;
+    DHTLogRecord rec;
+    const std::vector<uint8_t> &data = log.data;
+    size_t pos = 0, avail = 0, decoded = 0;
+    unsigned long mismatches = 0;
+    while (pos < data.size() && !decoder.isCorrupt())
+    {
+        avail = std::min(data.size(), avail + 1 + rand() % 7);
+        size_t used;
+        while (pos < avail)
+        {
+            bool sample = decoder.next(data.data() + pos, avail - pos, used, rec);
+            if (used == 0)
+                break;
+            pos += used;
+            if (sample)
+                mismatches += decoded >= ref.size() || !matches(rec, ref[decoded++]);
+        }
+    }
+    mismatches += ref.size() - decoded;
+
+    printf("round trip: %zu samples (%lu sweeps), %zu bytes, %.2f bytes/sample, %lu mismatches%s\n", ref.size(),
+           sweeps, data.size(), (double)data.size() / ref.size(), mismatches, decoder.isCorrupt() ? ", corrupt" : "");
+
+    // Encode rate: the same samples again, single records and full sweeps
+    NullPrint sink;
+    DHTLogEncoder single(sink);
+    const int rounds = 200;
+    auto t0 = std::chrono::steady_clock::now();
+    for (int r = 0; r < rounds; r++)
+        for (const Written &w : ref)
+            single.writeSample(w.id, w.type, w.status, w.hasFrame ? w.bytes : nullptr, w.timeMs);
+    double sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    printf("writeSample():       %.1f Msamples/s  (%.2f bytes/sample)\n", single.getSamplesWritten() / sec / 1e6,
+           (double)single.getBytesWritten() / single.getSamplesWritten());
+
+    DHTLogEncoder swept(sink);
+    for (uint8_t k = 0; k < BENCH_SENSORS; k++)
+        results[k].ready = true;
+    unsigned long sweepCalls = (unsigned long)rounds * ref.size() / BENCH_SENSORS;
+    t0 = std::chrono::steady_clock::now();
+    for (unsigned long r = 0; r < sweepCalls; r++)
+        swept.writeSweep(manager, results);
+    sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    printf("writeSweep() of %u:   %.1f Msamples/s  (%.2f bytes/sample)\n", BENCH_SENSORS,
+           swept.getSamplesWritten() / sec / 1e6, (double)swept.getBytesWritten() / swept.getSamplesWritten());
+
+    for (uint8_t k = 0; k < BENCH_SENSORS; k++)
+        delete sensors[k];
+    return mismatches ? 1 : 0;
+}
+
+int main(int argc, char **argv)
+{
+    TempUnit unit = Celsius;
+    FILE *in = stdin;
+
+    if (argc > 1 && !strcmp(argv[1], "--bench"))
+        return bench(argc > 2 ? strtoul(argv[2], nullptr, 10) : 20000);
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (!strcmp(argv[i], "-f"))
+            unit = Fahrenheit;
+        else if (!strcmp(argv[i], "-k"))
+            unit = Kelvin;
+        else if (!(in = fopen(argv[i], "rb")))
+        {
+            perror(argv[i]);
+            return 1;
+        }
+    }
+
+    printf("time_ms,id,sweep,type,status,temp,hum,dew,hi,raw\n");
+
+    DHTLogDecoder decoder;
+    DHTLogRecord rec;
+    uint8_t buf[4096];
+    size_t len = 0;
+    unsigned long samples = 0, bytes = 0;
+
+    for (;;)
+    {
+        size_t got = fread(buf + len, 1, sizeof(buf) - len, in);
+        len += got;
+
+        size_t pos = 0;
+        for (;;)
+        {
+            size_t used;
+            bool sample = decoder.next(buf + pos, len - pos, used, rec);
+            if (used == 0)
+                break;
+            pos += used;
+            if (!sample)
+                continue;
+
+            DHTData d = DHTLogDecoder::toData(rec, unit);
+            printf("%lu,%u,%d,%s,%d,%.1f,%.1f,%.1f,%.1f,", rec.timeMs, rec.id, rec.sweepSize ? rec.sweepIndex : -1,
+                   typeName(rec.type), rec.status, d.temp, d.hum, d.dew, d.hi);
+            if (rec.hasFrame)
+                printf("%02X%02X%02X%02X%02X", rec.bytes[0], rec.bytes[1], rec.bytes[2], rec.bytes[3], rec.bytes[4]);
+            printf("\n");
+            samples++;
+        }
+
+        bytes += pos;
+        memmove(buf, buf + pos, len - pos); // Keep a partial record for the next read
+        len -= pos;
+
+        if (got == 0 || decoder.isCorrupt())
+            break;
+    }
+
+    if (decoder.isCorrupt())
+        fprintf(stderr, "dhtlog: unknown record at byte %lu, stopped\n", bytes);
+    else if (len > 0)
+        fprintf(stderr, "dhtlog: %u trailing bytes (truncated record)\n", (unsigned)len);
+
+    fprintf(stderr, "%lu samples, %lu bytes, %.2f bytes/sample\n", samples, bytes,
+            samples ? (double)bytes / samples : 0.0);
+    return decoder.isCorrupt() ? 2 : 0;
+}
@@ -0,0 +1,126 @@
+/*
+  dhtmath: accuracy and speed of the dew point / heat index kernels (mydht::dewPointC(),
+  mydht::heatIndexF()) against the reference formulas in double precision.
+
+  Usage:  dhtmath
+
+  Accuracy: sweep of T -40.0..80.0 °C and RH 0.1..100.0 % in 0.1 steps (every DHT22 reading),
+  reporting the largest error of the library kernels and of the previous float implementation.
+  Integer RH values (every DHT11 reading) take the table path and are reported on their own.
+  Speed: ns per call on this host, previous implementation against the library kernels.
+
+  It also counts results that differ from the previous implementation at all: with
+  DHT_FAST_MATH 0 in myDHT_config.h (the reference path) there must be none.
+
+  Built on a host with the library and the mock Arduino core in extras/host:
+    make -C extras/host && extras/host/build/dhtmath
+*/
+
+#include "myDHTPro.h"
+#include <chrono>
+#include <math.h>
+#include <stdio.h>
+
+// Magnus formula and Rothfusz regression in double precision
+static double refDewPointC(double t, double rh)
+{
+    const double a = 17.27, b = 237.7;
+    double alpha = a * t / (b + t) + log(rh / 100.0);
+    return b * alpha / (a - alpha);
+}
+
+static double refHeatIndexF(double t, double rh)
+{
+    double hi = 0.5 * (t + 61.0 + (t - 68.0) * 1.2 + rh * 0.094);
+    if (hi >= 80)
+        hi = -42.379 + 2.04901523 * t + 10.14333127 * rh - 0.22475541 * t * rh - 0.00683783 * t * t -
+             0.05481717 * rh * rh + 0.00122874 * t * t * rh + 0.00085282 * t * rh * rh - 0.00000199 * t * t * rh * rh;
+    return hi;
+}
+
+// The library's formulas before the fast kernels, as they were written
+static float previousDewPointC(float tempC, float hum)
+{
+    double a = 17.27, b = 237.7;
+    double alpha = ((a * tempC) / (b + tempC)) + log(hum / 100.0);
+    return (b * alpha) / (a - alpha);
+}
+
+static float previousHeatIndexF(float t, float rh)
+{
+    float hi = 0.5 * (t + 61.0 + ((t - 68.0) * 1.2) + (rh * 0.094));
+    if (hi >= 80.0)
+        hi = -42.379 + 2.04901523 * t + 10.14333127 * rh - 0.22475541 * t * rh - 0.00683783 * t * t -
+             0.05481717 * rh * rh + 0.00122874 * t * t * rh + 0.00085282 * t * rh * rh - 0.00000199 * t * t * rh * rh;
+    return hi;
+}
+
+static void track(double &worst, double value, double ref)
+{
+    double e = fabs(value - ref);
+    if (e > worst)
+        worst = e;
+}
+
+template <typename F>
+static double nsPerCall(F fn)
+{
+    const long calls = 4000000;
+    volatile float sink = 0;
+    auto t0 = std::chrono::steady_clock::now();
+    for (long i = 0; i < calls; i++)
+        sink = sink + fn(i & 63);
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - t0).count() / calls;
+}
+
+int main()
+{
+    double dew = 0, dewInteger = 0, dewPrevious = 0, hi = 0, hiPrevious = 0;
+    unsigned long points = 0, differ = 0;
+
+    for (int t10 = -400; t10 <= 800; t10++)
+    {
+        for (int h10 = 1; h10 <= 1000; h10++)
+        {
+            float t = t10 / 10.0f, rh = h10 / 10.0f;
+            double ref = refDewPointC(t, rh);
+            track(dew, mydht::dewPointC(t, rh), ref);
+            track(dewPrevious, previousDewPointC(t, rh), ref);
+            if (h10 % 10 == 0)
+                track(dewInteger, mydht::dewPointC(t, rh), ref);
+
+            float tF = t * 9.0f / 5.0f + 32;
+            double refHi = refHeatIndexF(tF, rh);
+            track(hi, mydht::heatIndexF(tF, rh), refHi);
+            track(hiPrevious, previousHeatIndexF(tF, rh), refHi);
+
+            points++;
+            if ((float)mydht::dewPointC(t, rh) != previousDewPointC(t, rh) ||
+                mydht::heatIndexF(tF, rh) != previousHeatIndexF(tF, rh))
+                differ++;
+        }
+    }
+
+    printf("max error against double references (DHT_FAST_MATH %d)\n", DHT_FAST_MATH);
+    printf("  dew point   library %.6f °C (integer RH %.6f)   previous %.6f °C\n", dew, dewInteger, dewPrevious);
+    printf("  heat index  library %.6f °F                      previous %.6f °F\n", hi, hiPrevious);
+    printf("  %lu of %lu points differ from the previous implementation\n", differ, points);
+    printf("  dew point at 0 %%RH: %f (NaN expected)\n", mydht::dewPointC(20, 0));
+
+    float temps[64], hums[64];
+    for (int i = 0; i < 64; i++)
+    {
+        temps[i] = 15 + i * 0.3f;
+        hums[i] = 30 + i * 0.5f;
+    }
+
+    printf("ns per call on this host\n");
+    printf("  dew point   previous %.1f   library %.1f   library, integer RH %.1f\n",
+           nsPerCall([&](int i) { return previousDewPointC(temps[i], hums[i]); }),
+           nsPerCall([&](int i) { return (float)mydht::dewPointC(temps[i], hums[i]); }),
+           nsPerCall([&](int i) { return (float)mydht::dewPointC(temps[i], (float)(30 + i)); }));
+    printf("  heat index  previous %.1f   library %.1f\n",
+           nsPerCall([&](int i) { return previousHeatIndexF(80 + temps[i], hums[i]); }),
+           nsPerCall([&](int i) { return mydht::heatIndexF(80 + temps[i], hums[i]); }));
+    return 0;
+}
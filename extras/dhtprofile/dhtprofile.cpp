@@ -0,0 +1,159 @@
+/*
+  dhtprofile: lists the myDHT sensor profiles in a storage image, or checks the save/load round trip.
+
+  Usage:  dhtprofile image.bin          lists every valid profile record (e.g. an EEPROM dump
+                                        read with avrdude -U eeprom:r:image.bin:r)
+          dhtprofile -t image.bin       saves profiles of simulated sensors into image.bin
+                                        through DHTFileStorage, loads them back and compares
+                                        (and checks that setAdaptiveTiming() wins over a profile)
+
+  Built on a host with the library and the mock Arduino core in extras/host:
+    make -C extras/host && extras/host/build/dhtprofile
+*/
+
+#include "myDHT_profile.h"
+#include <stdio.h>
+#include <string.h>
+
+// File-backed profile storage: addresses are byte offsets in the file, which grows as needed
+class DHTFileStorage : public DHTProfileStorage
+{
+public:
+    DHTFileStorage(const char *path) : _path(path) {}
+
+    bool read(uint16_t address, uint8_t *data, uint8_t len) override
+    {
+        FILE *f = fopen(_path, "rb");
+        if (!f)
+            return false;
+        bool ok = fseek(f, address, SEEK_SET) == 0 && fread(data, 1, len, f) == len;
+        fclose(f);
+        return ok;
+    }
+
+    bool write(uint16_t address, const uint8_t *data, uint8_t len) override
+    {
+        FILE *f = fopen(_path, "r+b");
+        if (!f)
+            f = fopen(_path, "w+b");
+        if (!f)
+            return false;
+
+        // Unwritten bytes before the record read as erased EEPROM
+        fseek(f, 0, SEEK_END);
+        for (long end = ftell(f); end < address; end++)
+            fputc(0xFF, f);
+
+        bool ok = fseek(f, address, SEEK_SET) == 0 && fwrite(data, 1, len, f) == len;
+        return fclose(f) == 0 && ok;
+    }
+
+private:
+    const char *_path;
+};
+
+static void printProfile(long address, const DHTProfile &p)
+{
+    printf("@%-5ld pin %-3u %s  retries %u  offsets %+.2f C %+.2f %%RH  threshold %u us  bit timeout %u us",
+           address, p.pin, p.type == DHT11 ? "DHT11" : "DHT22", p.retries, p.tempOffsetC, p.humidityOffset,
+           p.highThresholdUs, p.bitTimeoutUs);
+    if (p.adaptiveTiming)
+        printf("  adaptive (0: %.1f us, 1: %.1f us)", p.zeroHighQ4 / 16.0, p.oneHighQ4 / 16.0);
+    printf("\n");
+}
+
+static int list(const char *path)
+{
+    FILE *f = fopen(path, "rb");
+    if (!f)
+    {
+        perror(path);
+        return 1;
+    }
+    static uint8_t image[65536];
+    size_t len = fread(image, 1, sizeof(image), f);
+    fclose(f);
+
+    int found = 0;
+    for (size_t pos = 0; pos + DHT_PROFILE_BYTES <= len; pos++)
+    {
+        DHTProfile p;
+        if (DHTProfile::decode(image + pos, p))
+        {
+            printProfile((long)pos, p);
+            found++;
+        }
+    }
+    fprintf(stderr, "%d profiles in %u bytes\n", found, (unsigned)len);
+    return 0;
+}
+
+static bool sameProfile(const DHTProfile &a, const DHTProfile &b)
+{
+    return a.pin == b.pin && a.type == b.type && a.adaptiveTiming == b.adaptiveTiming && a.retries == b.retries &&
+           a.tempOffsetC == b.tempOffsetC && a.humidityOffset == b.humidityOffset &&
+           a.highThresholdUs == b.highThresholdUs && a.bitTimeoutUs == b.bitTimeoutUs &&
+           a.zeroHighQ4 == b.zeroHighQ4 && a.oneHighQ4 == b.oneHighQ4;
+}
+
+static int roundTrip(const char *path)
+{
+    remove(path);
+    DHTFileStorage storage(path);
+    int failures = 0;
+
+    for (uint8_t pin = 2; pin < 10; pin++)
+    {
+        MyDHT saved(pin, (pin & 1) ? DHT11 : DHT22, 2 + pin % 4);
+        saved.setTemperatureOffset(-0.35f * pin);
+        saved.setHumidityOffset(1.25f * pin);
+        saved.setAdaptiveTiming(pin & 2);
+
+        uint16_t address = (pin - 2) * DHT_PROFILE_BYTES;
+        MyDHT loaded(pin);
+        MyDHT otherPin(pin + 1);
+        bool ok = saved.saveProfile(storage, address) && loaded.loadProfile(storage, address) &&
+                  sameProfile(saved.getProfile(), loaded.getProfile()) &&
+                  !otherPin.loadProfile(storage, address); // Profiles are bound to their pin
+        printf("pin %u: %s\n", pin, ok ? "ok" : "MISMATCH");
+        failures += !ok;
+    }
+
+    // An explicit setAdaptiveTiming() before loading wins over the profile's flag (pin 2: adaptive on)
+    MyDHT explicitOff(2);
+    explicitOff.setAdaptiveTiming(false);
+    if (!explicitOff.loadProfile(storage, 0) || explicitOff.getProfile().adaptiveTiming)
+    {
+        printf("setAdaptiveTiming(false) overridden by the profile\n");
+        failures++;
+    }
+
+    // A flipped bit anywhere in a record must be rejected by the CRC
+    uint8_t record[DHT_PROFILE_BYTES];
+    storage.read(0, record, sizeof(record));
+    for (uint8_t bit = 0; bit < DHT_PROFILE_BYTES * 8; bit++)
+    {
+        record[bit >> 3] ^= 1 << (bit & 7);
+        DHTProfile p;
+        if (DHTProfile::decode(record, p))
+        {
+            printf("bit %u flip not detected\n", bit);
+            failures++;
+        }
+        record[bit >> 3] ^= 1 << (bit & 7);
+    }
+
+    printf("%s\n", failures ? "FAILED" : "round trip ok");
+    return failures ? 2 : 0;
+}
+
+int main(int argc, char **argv)
+{
+    if (argc == 3 && !strcmp(argv[1], "-t"))
+        return roundTrip(argv[2]);
+    if (argc == 2)
+        return list(argv[1]);
+
+    fprintf(stderr, "usage: dhtprofile [-t] image.bin\n");
+    return 1;
+}
@@ -0,0 +1,163 @@
+/*
+  dhtqueue: two-thread stress test of DHTQueue, the lock-free single-producer / single-consumer queue.
+
+  Usage:  dhtqueue [records]      (default: 1000000 per case)
+
+  A producer thread pushes numbered records (record i: timeMs = i, seq = i mod 65536, temperature and
+  humidity derived from i) while the consumer thread pops them one at a time or with drain(), for
+  capacities 1, 8 and 254. Two producer modes:
+    retry   a full queue is retried until the push succeeds: every record must arrive, in order
+    drop    a full queue drops the record, and the producer pauses at random between pushes: the
+            records that do arrive must be in order, and the gaps in their numbers must add up to
+            the drops counted by the producer and by getDropped()
+  Every record is also checked field by field, so a slot read before it was completely written
+  (a missing release / acquire) shows up as a corrupt record. Any failure fails the run.
+
+  Built on a host with the library and the mock Arduino core in extras/host:
+    make -C extras/host && extras/host/build/dhtqueue
+  With ThreadSanitizer:
+    make -C extras/host CXXFLAGS="-O1 -g -fsanitize=thread" LDFLAGS=-fsanitize=thread BUILD=build-tsan
+*/
+
+#include "myDHTPro.h"
+#include <atomic>
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include <thread>
+
+static MyDHT sensor(2, DHT22);
+
+static DHTReading makeRecord(uint32_t i)
+{
+    DHTReading r;
+    r.sensor = &sensor;
+    r.timeMs = i;
+    r.seq = (uint16_t)i;
+    r.tempC10 = (int16_t)(i * 7);
+    r.hum10 = (uint16_t)(i ^ 0x5A5A);
+    r.status = i % 7;
+    return r;
+}
+
+static bool intact(const DHTReading &r)
+{
+    DHTReading expected = makeRecord(r.timeMs);
+    return r.sensor == expected.sensor && r.seq == expected.seq && r.tempC10 == expected.tempC10 &&
+           r.hum10 == expected.hum10 && r.status == expected.status;
+}
+
+struct Result
+{
+    uint32_t received = 0;
+    uint32_t corrupt = 0;
+    uint32_t outOfOrder = 0;
+    uint32_t gaps = 0; // Records missing between two received ones, and after the last one
+    uint32_t drops = 0; // Failed pushes counted by the producer (retried in retry mode)
+    double seconds = 0;
+};
+
+static Result run(DHTQueueBase &queue, uint32_t records, bool retry, bool batch)
+{
+    Result res;
+    std::atomic<bool> done(false);
+    auto t0 = std::chrono::steady_clock::now();
+
+    std::thread producer([&] {
+        uint32_t lfsr = 1;
+        for (uint32_t i = 0; i < records; i++)
+        {
+            DHTReading r = makeRecord(i);
+            while (!queue.push(r))
+            {
+                if (res.drops++ % 256 == 255)
+                    std::this_thread::yield(); // Polls mostly, but lets a single core run the consumer
+                if (!retry)
+                    break;
+            }
+
+            // Drop mode: a random pause after each push, so that the queue fills only in bursts
+            if (!retry)
+            {
+                lfsr = lfsr * 1103515245 + 12345;
+                for (volatile uint32_t spin = (lfsr >> 16) & 127; spin; spin--)
+                {
+                }
+            }
+        }
+        done = true;
+    });
+
+    DHTReading buf[16];
+    uint32_t next = 0; // Number of the record expected next
+    uint32_t idle = 0;
+    for (;;)
+    {
+        bool finished = done.load(); // Read before draining: nothing can arrive after an empty drain then
+        uint8_t n = batch ? queue.drain(buf, 16) : queue.pop(buf[0]);
+        if (n == 0)
+        {
+            if (finished)
+                break;
+            if (++idle % 256 == 0)
+                std::this_thread::yield();
+        }
+
+        for (uint8_t k = 0; k < n; k++)
+        {
+            const DHTReading &r = buf[k];
+            res.received++;
+            if (!intact(r))
+            {
+                res.corrupt++;
+                continue;
+            }
+            if (r.timeMs < next)
+            {
+                res.outOfOrder++;
+                continue;
+            }
+            res.gaps += r.timeMs - next;
+            next = r.timeMs + 1;
+        }
+    }
+    producer.join();
+
+    res.gaps += records - next;
+    res.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    return res;
+}
+
+template <uint8_t N>
+static int stress(uint32_t records)
+{
+    int failures = 0;
+    for (int mode = 0; mode < 4; mode++)
+    {
+        bool retry = mode < 2, batch = mode & 1;
+        DHTQueue<N> queue;
+        Result r = run(queue, records, retry, batch);
+
+        // In retry mode every failed push is retried, so nothing may be missing
+        uint32_t lost = retry ? 0 : r.drops;
+        bool ok = r.corrupt == 0 && r.outOfOrder == 0 && r.gaps == lost && r.received == records - lost &&
+                  queue.getDropped() == (uint16_t)r.drops;
+        failures += !ok;
+
+        printf("  %3u  %-5s %-5s  received %8u  full %8u  corrupt %u  out of order %u  %6.1f Mrec/s  %s\n", N,
+               retry ? "retry" : "drop", batch ? "drain" : "pop", r.received, r.drops, r.corrupt, r.outOfOrder,
+               r.received / r.seconds / 1e6, ok ? "ok" : "FAILED");
+    }
+    return failures;
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t records = argc > 1 ? strtoul(argv[1], nullptr, 10) : 1000000;
+
+    printf("%u records per case, producer and consumer on two threads\n", records);
+    printf("  cap  mode  read\n");
+    int failures = stress<1>(records) + stress<8>(records) + stress<254>(records);
+    printf("%s\n", failures ? "FAILED" : "all cases ok");
+    return failures ? 1 : 0;
+}
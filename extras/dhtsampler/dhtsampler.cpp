@@ -0,0 +1,282 @@
+/*
+  dhtsampler: replays a temperature / humidity trace through DHTAdaptiveSampler and through
+  fixed-rate reads at getMinReadInterval(), and compares reads taken against tracking error.
+
+  Usage:  dhtsampler [trace.csv] [tempStepC humStep maxIntervalS]
+
+  trace.csv has one "seconds,tempC,humidity" row per line (a logger export, for example);
+  values in between are interpolated linearly. Without a file, three built-in 24 h scenarios
+  are replayed: a stable basement, an office with HVAC cycling and window airing, and a
+  bathroom with two showers. The default policy is the sampler's: 0.3 °C, 1 %RH, 60 s.
+
+  The simulated DHT22 is a test-mode MyDHT that gets the trace value at the time of each read,
+  with +-0.05 unit noise and 0.1 unit resolution. Tracking error is the difference between the
+  last reading and the trace, sampled every second.
+
+  Built on a host with the library and the mock Arduino core in extras/host:
+    make -C extras/host && extras/host/build/dhtsampler
+  The mock clock is virtual (delay() advances millis() at once), so a day is replayed in well
+  under a second.
+*/
+
+#include "myDHT_sampler.h"
+#include <algorithm>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+
+struct TracePoint
+{
+    double s; // Seconds since the start of the trace
+    double tempC;
+    double hum;
+};
+
+static std::vector<TracePoint> trace;
+
+// Trace value at time s, linear between points
+static TracePoint at(double s)
+{
+    size_t lo = 0, hi = trace.size() - 1;
+    if (s <= trace[lo].s)
+        return trace[lo];
+    if (s >= trace[hi].s)
+        return trace[hi];
+    while (hi - lo > 1)
+    {
+        size_t mid = (lo + hi) / 2;
+        (trace[mid].s <= s ? lo : hi) = mid;
+    }
+    double f = (s - trace[lo].s) / (trace[hi].s - trace[lo].s);
+    TracePoint p = {s, trace[lo].tempC + f * (trace[hi].tempC - trace[lo].tempC),
+                    trace[lo].hum + f * (trace[hi].hum - trace[lo].hum)};
+    return p;
+}
+
+static bool loadCsv(const char *path)
+{
+    FILE *f = fopen(path, "r");
+    if (!f)
+    {
+        perror(path);
+        return false;
+    }
+    char line[128];
+    while (fgets(line, sizeof(line), f))
+    {
+        TracePoint p;
+        if (sscanf(line, "%lf,%lf,%lf", &p.s, &p.tempC, &p.hum) == 3)
+            trace.push_back(p);
+    }
+    fclose(f);
+    return trace.size() >= 2;
+}
+
+// Built-in scenarios, one point per 10 s over 24 h
+static void buildScenario(int scenario)
+{
+    trace.clear();
+    for (double s = 0; s <= 86400; s += 10)
+    {
+        double h = s / 3600;
+        double day = sin((h - 9) * M_PI / 12); // Warmest mid-afternoon
+        TracePoint p = {s, 0, 0};
+
+        if (scenario == 0) // Basement: slow daily swing
+        {
+            p.tempC = 16 + 0.4 * day;
+            p.hum = 62 - 1.5 * day;
+        }
+        else if (scenario == 1) // Office: heating cycles in working hours, airing at 10:00 and 15:00
+        {
+            p.tempC = 21 + 1.0 * day;
+            p.hum = 45 - 4 * day;
+            if (h >= 7 && h < 19)
+                p.tempC += 0.4 * sin(s * 2 * M_PI / 1200); // 20 min thermostat cycle
+            for (double open = 10; open <= 15; open += 5)
+            {
+                double m = (h - open) * 60; // Minutes since the window opened
+                if (m >= 0 && m < 10)
+                    p.tempC -= 3 * m / 10, p.hum += 8 * m / 10;
+                else if (m >= 10)
+                    p.tempC -= 3 * exp(-(m - 10) / 15), p.hum += 8 * exp(-(m - 10) / 15);
+            }
+        }
+        else // Bathroom: showers at 7:00 and 21:00
+        {
+            p.tempC = 22 + 0.5 * day;
+            p.hum = 50 - 3 * day;
+            for (double shower = 7; shower <= 21; shower += 14)
+            {
+                double m = (h - shower) * 60;
+                if (m >= 0 && m < 8)
+                    p.hum += 40 * m / 8, p.tempC += 2 * m / 8;
+                else if (m >= 8)
+                    p.hum += 40 * exp(-(m - 8) / 12), p.tempC += 2 * exp(-(m - 8) / 20);
+            }
+        }
+        trace.push_back(p);
+    }
+}
+
+static double noise()
+{
+    return (rand() / (double)RAND_MAX - 0.5) * 0.1;
+}
+
+// Feeds the sensor the trace value at time s as a DHT22 frame
+static void present(MyDHT &sensor, double s)
+{
+    TracePoint p = at(s);
+    long t10 = lround((p.tempC + noise()) * 10);
+    long h10 = lround((p.hum + noise()) * 10);
+    if (h10 < 0)
+        h10 = 0;
+    if (h10 > 1000)
+        h10 = 1000;
+    uint16_t t = t10 < 0 ? (uint16_t)(0x8000 | -t10) : (uint16_t)t10;
+    uint8_t b[4] = {(uint8_t)(h10 >> 8), (uint8_t)h10, (uint8_t)(t >> 8), (uint8_t)t};
+    sensor.setRawBytes(b[0], b[1], b[2], b[3], (uint8_t)(b[0] + b[1] + b[2] + b[3]));
+}
+
+struct Reading
+{
+    double s;
+    double tempC;
+    double hum;
+};
+
+struct Result
+{
+    unsigned long reads;
+    double meanTemp, p99Temp, maxTemp;
+    double meanHum, p99Hum, maxHum;
+};
+
+// Hold error of the readings against the trace, every second
+static Result evaluate(const std::vector<Reading> &readings)
+{
+    Result r = {readings.size(), 0, 0, 0, 0, 0, 0};
+    std::vector<double> et, eh;
+    size_t k = 0;
+    for (double s = readings[0].s; s <= trace.back().s; s += 1)
+    {
+        while (k + 1 < readings.size() && readings[k + 1].s <= s)
+            k++;
+        TracePoint p = at(s);
+        et.push_back(fabs(readings[k].tempC - p.tempC));
+        eh.push_back(fabs(readings[k].hum - p.hum));
+    }
+
+    std::vector<double> *errs[2] = {&et, &eh};
+    double *out[2][3] = {{&r.meanTemp, &r.p99Temp, &r.maxTemp}, {&r.meanHum, &r.p99Hum, &r.maxHum}};
+    for (int c = 0; c < 2; c++)
+    {
+        std::vector<double> &e = *errs[c];
+        double sum = 0;
+        for (double v : e)
+            sum += v;
+        std::sort(e.begin(), e.end());
+        *out[c][0] = sum / e.size();
+        *out[c][1] = e[(size_t)(e.size() * 0.99)];
+        *out[c][2] = e.back();
+    }
+    return r;
+}
+
+static void waitUntil(unsigned long dueMs)
+{
+    unsigned long now = millis();
+    if ((long)(dueMs - now) > 0)
+        delay(dueMs - now);
+}
+
+static Result replay(bool adaptive, const DHTSamplingPolicy &policy)
+{
+    MyDHT sensor(2, DHT22);
+    sensor.testMode = true;
+    DHTAdaptiveSampler sampler(sensor);
+    sampler.setPolicy(policy);
+
+    std::vector<Reading> readings;
+    unsigned long startMs = millis();
+    unsigned long fixedDueMs = startMs;
+    double endS = trace.back().s;
+
+    for (;;)
+    {
+        waitUntil(adaptive ? sampler.nextReadDueMs() : fixedDueMs);
+        double s = (millis() - startMs) / 1000.0;
+        if (s > endS)
+            break;
+
+        present(sensor, s);
+        DHTError err = adaptive ? sampler.update() : sensor.read();
+        fixedDueMs = millis() + sensor.getMinReadInterval();
+        if (err == DHT_OK)
+        {
+            Reading r = {s, sensor.getTemperature(), sensor.getHumidity()};
+            readings.push_back(r);
+        }
+    }
+    return evaluate(readings);
+}
+
+static void report(const char *name, const DHTSamplingPolicy &policy)
+{
+    Result fixed = replay(false, policy);
+    Result adaptive = replay(true, policy);
+
+    printf("%s\n", name);
+    printf("  %-9s %6s  %-24s %-24s\n", "", "reads", "temp error mean/p99/max", "hum error mean/p99/max");
+    const Result *rows[2] = {&fixed, &adaptive};
+    const char *labels[2] = {"fixed", "adaptive"};
+    for (int i = 0; i < 2; i++)
+        printf("  %-9s %6lu  %5.2f / %5.2f / %5.2f °C  %5.2f / %5.2f / %5.2f %%\n", labels[i], rows[i]->reads,
+               rows[i]->meanTemp, rows[i]->p99Temp, rows[i]->maxTemp, rows[i]->meanHum, rows[i]->p99Hum, rows[i]->maxHum);
+    printf("  reads saved: %.1f%%\n", 100.0 * (1.0 - (double)adaptive.reads / fixed.reads));
+}
+
+int main(int argc, char **argv)
+{
+    DHTSamplingPolicy policy = {3, 10, 60000, 2}; // The sampler's default
+    const char *csv = nullptr;
+    int arg = 1;
+    if (argc == 2 || argc == 5)
+        csv = argv[arg++];
+    if (argc - arg == 3)
+    {
+        policy.tempStepC10 = (uint16_t)lround(atof(argv[arg]) * 10);
+        policy.humStep10 = (uint16_t)lround(atof(argv[arg + 1]) * 10);
+        policy.maxIntervalMs = (uint32_t)(atof(argv[arg + 2]) * 1000);
+    }
+    else if (argc - arg != 0)
+    {
+        fprintf(stderr, "usage: dhtsampler [trace.csv] [tempStepC humStep maxIntervalS]\n");
+        return 1;
+    }
+
+    printf("policy: %.1f °C, %.1f %%RH, max %lu s, growth x%u\n", policy.tempStepC10 / 10.0,
+           policy.humStep10 / 10.0, (unsigned long)(policy.maxIntervalMs / 1000), policy.growth);
+
+    srand(1);
+    if (csv)
+    {
+        if (!loadCsv(csv))
+        {
+            fprintf(stderr, "%s: need at least two \"seconds,tempC,humidity\" rows\n", csv);
+            return 1;
+        }
+        report(csv, policy);
+        return 0;
+    }
+
+    const char *names[3] = {"basement (stable)", "office (HVAC cycles, airing)", "bathroom (showers)"};
+    for (int scenario = 0; scenario < 3; scenario++)
+    {
+        buildScenario(scenario);
+        report(names[scenario], policy);
+    }
+    return 0;
+}
@@ -0,0 +1,155 @@
+/*
+  dhtservice: contention benchmark for DHTService snapshots.
+
+  Usage:  dhtservice [readers] [seconds]      (default: 3 readers, 2 s per phase)
+
+  Four test-mode sensors are polled by a DHTService thread while reader threads call getLatest()
+  in a tight loop. The service callback feeds each sensor a new frame after every read, with
+  temperature and humidity both derived from the read number, so a torn snapshot (fields from
+  two different readings) is detected. Two phases are measured: readers alone (service stopped,
+  snapshots static) and readers while the service publishes.
+
+  Built on a host with the library and the mock Arduino core in extras/host:
+    make -C extras/host && extras/host/build/dhtservice
+
+  On the virtual clock of the mock, delay() returns at once and the service publishes as fast
+  as it can read, the worst case for the readers.
+*/
+
+#include "myDHT_service.h"
+#include <atomic>
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+
+static const uint8_t SENSORS = 4;
+
+static MyDHT *sensors[SENSORS];
+static uint32_t frames[SENSORS]; // Frames fed to each sensor so far (service thread only)
+
+// Frame number k: 0.0-79.9 °C and 0.0-99.9 %RH, both from k, as DHT22 bytes
+static void setFrame(MyDHT &sensor, uint16_t k)
+{
+    uint16_t hum = k % 1000;
+    uint16_t temp = k % 800;
+    uint8_t b[4] = {(uint8_t)(hum >> 8), (uint8_t)hum, (uint8_t)(temp >> 8), (uint8_t)temp};
+    sensor.setRawBytes(b[0], b[1], b[2], b[3], (uint8_t)(b[0] + b[1] + b[2] + b[3]));
+}
+
+// Service thread: the next read of this sensor returns the next frame
+static void onReading(const DHTReading &reading, void *)
+{
+    for (uint8_t i = 0; i < SENSORS; i++)
+        if (sensors[i] == reading.sensor)
+            setFrame(*sensors[i], (uint16_t)++frames[i]);
+}
+
+// Reading number seq was taken from frame seq - 1
+static bool consistent(const DHTReading &r)
+{
+    uint16_t k = (uint16_t)(r.seq - 1);
+    return r.status == DHT_OK && r.tempC10 == k % 800 && r.hum10 == k % 1000;
+}
+
+struct ReaderStats
+{
+    uint64_t reads = 0;
+    uint64_t torn = 0;
+    uint64_t backwards = 0; // A newer reading followed by an older one of the same sensor
+};
+
+static void reader(DHTServiceBase *service, std::atomic<bool> *done, ReaderStats *stats)
+{
+    uint16_t lastSeq[SENSORS] = {};
+    uint8_t i = 0;
+    while (!done->load(std::memory_order_relaxed))
+    {
+        DHTReading r;
+        if (service->getLatest(i, r))
+        {
+            stats->reads++;
+            if (!consistent(r))
+                stats->torn++;
+            if ((int16_t)(r.seq - lastSeq[i]) < 0)
+                stats->backwards++;
+            lastSeq[i] = r.seq;
+        }
+        i = (i + 1 == SENSORS) ? 0 : i + 1;
+    }
+}
+
+static ReaderStats phase(DHTServiceBase &service, int readers, double seconds, bool polling)
+{
+    if (polling)
+        service.start();
+
+    std::atomic<bool> done(false);
+    std::vector<ReaderStats> stats(readers);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < readers; t++)
+        threads.emplace_back(reader, &service, &done, &stats[t]);
+
+    auto until = std::chrono::steady_clock::now() + std::chrono::duration<double>(seconds);
+    while (std::chrono::steady_clock::now() < until)
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    done = true;
+    for (auto &t : threads)
+        t.join();
+
+    if (polling)
+        service.stop();
+
+    ReaderStats total;
+    for (auto &s : stats)
+    {
+        total.reads += s.reads;
+        total.torn += s.torn;
+        total.backwards += s.backwards;
+    }
+    return total;
+}
+
+int main(int argc, char **argv)
+{
+    int readers = argc > 1 ? atoi(argv[1]) : 3;
+    double seconds = argc > 2 ? atof(argv[2]) : 2.0;
+
+    DHTService<SENSORS> service;
+    for (uint8_t i = 0; i < SENSORS; i++)
+    {
+        sensors[i] = new MyDHT(2 + i, DHT22);
+        sensors[i]->testMode = true;
+        setFrame(*sensors[i], 0);
+        service.add(*sensors[i]);
+    }
+    service.setCallback(onReading);
+
+    // One published reading per sensor, so the idle phase has snapshots to read
+    service.start();
+    DHTReading r;
+    for (uint8_t i = 0; i < SENSORS; i++)
+        while (!service.getLatest(i, r))
+            std::this_thread::yield();
+    service.stop();
+
+    uint32_t before = 0;
+    for (uint8_t i = 0; i < SENSORS; i++)
+        before += frames[i];
+
+    ReaderStats idle = phase(service, readers, seconds, false);
+    ReaderStats busy = phase(service, readers, seconds, true);
+
+    uint32_t published = 0;
+    for (uint8_t i = 0; i < SENSORS; i++)
+        published += frames[i];
+    published -= before;
+
+    printf("%d readers, %u sensors, %.1f s per phase\n", readers, SENSORS, seconds);
+    printf("service stopped:    %10.0f snapshots/s\n", idle.reads / seconds);
+    printf("service publishing: %10.0f snapshots/s  (%.0f readings/s published, %.0f%% of idle)\n",
+           busy.reads / seconds, published / seconds, idle.reads ? 100.0 * busy.reads / idle.reads : 0.0);
+    printf("torn %llu, out of order %llu\n", (unsigned long long)(idle.torn + busy.torn),
+           (unsigned long long)(idle.backwards + busy.backwards));
+    return (idle.torn + busy.torn + idle.backwards + busy.backwards) ? 2 : 0;
+}
@@ -0,0 +1,88 @@
+/*
+  dhttrace: renders binary myDHT trace batches (DHTTrace::flush) as the debug messages.
+
+  Usage:  dhttrace [capture.bin]     (reads stdin without a file)
+
+  Built on a host with the library and the mock Arduino core in extras/host:
+    make -C extras/host && extras/host/build/dhttrace
+
+  The capture may mix batches with other serial output: the tool scans for the batch header
+  and skips anything that does not decode to valid events.
+  Output columns: time in us (micros() on the board), pin, message.
+*/
+
+#include "myDHT_trace.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+// Length of a valid batch starting at data[0], or 0
+static size_t batchLength(const uint8_t *data, size_t len)
+{
+    if (len < 2 || data[0] != DHT_TRACE_MAGIC)
+        return 0;
+
+    size_t need = 2 + (size_t)data[1] * DHT_TRACE_RECORD_BYTES;
+    if (need > len)
+        return 0;
+
+    for (size_t pos = 2; pos < need; pos += DHT_TRACE_RECORD_BYTES)
+    {
+        if (data[pos + 4] >= DHT_TRACE_EVENT_COUNT)
+            return 0;
+    }
+    return need;
+}
+
+int main(int argc, char **argv)
+{
+    FILE *in = stdin;
+    if (argc > 1 && !(in = fopen(argv[1], "rb")))
+    {
+        perror(argv[1]);
+        return 1;
+    }
+
+    // Traces are small: read the whole capture
+    size_t len = 0, cap = 4096;
+    uint8_t *data = (uint8_t *)malloc(cap);
+    size_t got;
+    while (data && (got = fread(data + len, 1, cap - len, in)) > 0)
+    {
+        len += got;
+        if (len == cap)
+            data = (uint8_t *)realloc(data, cap *= 2);
+    }
+    if (!data)
+    {
+        fprintf(stderr, "dhttrace: out of memory\n");
+        return 1;
+    }
+
+    unsigned long events = 0, batches = 0, skipped = 0;
+    char line[96];
+
+    for (size_t pos = 0; pos < len;)
+    {
+        size_t batch = batchLength(data + pos, len - pos);
+        if (batch == 0)
+        {
+            pos++;
+            skipped++;
+            continue;
+        }
+
+        for (size_t rec = pos + 2; rec < pos + batch; rec += DHT_TRACE_RECORD_BYTES)
+        {
+            DHTTraceRecord event = DHTTrace::decode(data + rec);
+            DHTTrace::format(event, line, sizeof(line));
+            printf("%10lu %3u  %s\n", (unsigned long)event.timeUs, event.pin, line);
+            events++;
+        }
+        pos += batch;
+        batches++;
+    }
+
+    fprintf(stderr, "%lu events in %lu batches, %lu other bytes skipped\n", events, batches, skipped);
+    free(data);
+    return 0;
+}
@@ -0,0 +1,251 @@
+#include "Arduino.h"
+#include "dht_sim.h"
+
+HardwareSerial Serial;
+
+namespace sim
+{
+    std::atomic<uint64_t> nowNs(0);
+    uint32_t microsCostNs = 3500;
+    uint32_t readCostNs = 3000;
+    uint32_t pinCostNs = 4000;
+    unsigned long microsCalls = 0;
+    unsigned long readCalls = 0;
+    Sensor sensors[PINS];
+}
+
+namespace
+{
+    uint8_t pinModes[sim::PINS];
+    uint8_t outLevels[sim::PINS];
+    uint64_t lowStartNs[sim::PINS]; // Driver pulled the line LOW (start pulse)
+    uint64_t pulseNs[sim::PINS];    // Length of the last start pulse not answered yet
+    void (*isrs[sim::PINS])();
+    uint8_t attached = 0; // Pins with an interrupt
+    bool irqDisabled = false;
+    bool inIsr = false;
+
+#if defined(MYDHT_HOST_PORTS)
+    constexpr uint8_t PORTS = sim::PINS / 8;
+    volatile uint32_t portIn[PORTS];
+    uint8_t portEdge[sim::PINS]; // Edges of the current frame already in portIn (time only moves forward)
+
+    // Brings the port input registers to the current virtual time
+    void updatePorts()
+    {
+        uint32_t in[PORTS] = {};
+        for (uint8_t p = 0; p < sim::PINS; p++)
+        {
+            const sim::Sensor &s = sim::sensors[p];
+            while (portEdge[p] < s.edgeCount && s.edges[portEdge[p]] <= sim::nowNs)
+                portEdge[p]++;
+
+            int lvl = (pinModes[p] == OUTPUT) ? outLevels[p] : !(portEdge[p] & 1); // Idles HIGH, toggles per edge
+            if (lvl)
+                in[p / 8] |= 1u << (p % 8);
+        }
+        for (uint8_t k = 0; k < PORTS; k++)
+            portIn[k] = in[k];
+    }
+#else
+    inline void updatePorts() {}
+#endif
+
+    // Runs, in time order, the interrupts of every edge up to untilNs
+    void fireEdges(uint64_t untilNs)
+    {
+        if (irqDisabled || inIsr || !attached)
+            return;
+
+        for (;;)
+        {
+            int8_t next = -1;
+            uint64_t nextNs = untilNs;
+            for (uint8_t p = 0; p < sim::PINS; p++)
+            {
+                sim::Sensor &s = sim::sensors[p];
+                if (isrs[p] && s.nextIrqEdge < s.edgeCount && s.edges[s.nextIrqEdge] <= nextNs)
+                {
+                    next = p;
+                    nextNs = s.edges[s.nextIrqEdge];
+                }
+            }
+            if (next < 0)
+                return;
+
+            sim::sensors[next].nextIrqEdge++;
+            if (sim::nowNs < nextNs)
+                sim::nowNs = nextNs;
+            updatePorts();
+
+            inIsr = true;
+            isrs[next]();
+            inIsr = false;
+        }
+    }
+
+    void charge(uint32_t ns)
+    {
+        sim::advanceNs(ns);
+    }
+
+    bool validPin(uint8_t pin)
+    {
+        return pin < sim::PINS;
+    }
+
+    // Lines idle HIGH from the start
+    struct Init
+    {
+        Init() { sim::reset(); }
+    } init;
+}
+
+void sim::advanceNs(uint64_t ns)
+{
+    uint64_t target = nowNs + ns;
+    fireEdges(target);
+    if (nowNs < target)
+        nowNs = target;
+    updatePorts();
+}
+
+void sim::reset()
+{
+    nowNs = 0;
+    microsCostNs = 3500;
+    readCostNs = 3000;
+    pinCostNs = 4000;
+    microsCalls = 0;
+    readCalls = 0;
+    for (uint8_t p = 0; p < PINS; p++)
+    {
+        sensors[p] = Sensor();
+        pinModes[p] = INPUT;
+        outLevels[p] = HIGH;
+        lowStartNs[p] = 0;
+        pulseNs[p] = 0;
+        isrs[p] = nullptr;
+#if defined(MYDHT_HOST_PORTS)
+        portEdge[p] = 0;
+#endif
+    }
+    attached = 0;
+    irqDisabled = false;
+    updatePorts();
+}
+
+unsigned long micros()
+{
+    sim::microsCalls++;
+    charge(sim::microsCostNs);
+    return (unsigned long)(sim::nowNs / 1000);
+}
+
+unsigned long millis()
+{
+    charge(sim::microsCostNs);
+    return (unsigned long)(sim::nowNs / 1000000);
+}
+
+void delay(unsigned long ms)
+{
+    sim::advanceNs((uint64_t)ms * 1000000);
+}
+
+void delayMicroseconds(unsigned int us)
+{
+    sim::advanceNs((uint64_t)us * 1000);
+}
+
+void pinMode(uint8_t pin, uint8_t mode)
+{
+    charge(sim::pinCostNs);
+    if (!validPin(pin))
+        return;
+
+    // The sensor answers once the line is released to the pull-up after a long enough start pulse
+    if (pinModes[pin] == OUTPUT && mode != OUTPUT)
+    {
+        if (outLevels[pin] == LOW)
+            pulseNs[pin] = sim::nowNs - lowStartNs[pin];
+
+        sim::Sensor &s = sim::sensors[pin];
+        if (s.present && pulseNs[pin] && pulseNs[pin] >= s.minStartNs)
+        {
+            s.trigger(sim::nowNs);
+#if defined(MYDHT_HOST_PORTS)
+            portEdge[pin] = 0;
+#endif
+        }
+        pulseNs[pin] = 0;
+    }
+
+    pinModes[pin] = mode;
+    updatePorts();
+}
+
+void digitalWrite(uint8_t pin, uint8_t val)
+{
+    charge(sim::pinCostNs);
+    if (!validPin(pin))
+        return;
+
+    if (val == LOW && outLevels[pin] != LOW)
+        lowStartNs[pin] = sim::nowNs;
+    else if (val != LOW && outLevels[pin] == LOW && pinModes[pin] == OUTPUT)
+        pulseNs[pin] = sim::nowNs - lowStartNs[pin]; // End of the start pulse
+    outLevels[pin] = val;
+    updatePorts();
+}
+
+int digitalRead(uint8_t pin)
+{
+    sim::readCalls++;
+    charge(sim::readCostNs);
+    if (!validPin(pin))
+        return HIGH;
+    if (pinModes[pin] == OUTPUT)
+        return outLevels[pin];
+    return sim::sensors[pin].level(sim::nowNs);
+}
+
+#if defined(MYDHT_HOST_PORTS)
+const volatile uint32_t *portInputRegister(uint8_t port)
+{
+    return port < PORTS ? &portIn[port] : nullptr;
+}
+#endif
+
+void attachInterrupt(int irq, void (*isr)(), int)
+{
+    if (irq < 0 || irq >= sim::PINS)
+        return;
+
+    // Edges already in the past are not reported, as on hardware
+    sim::Sensor &s = sim::sensors[irq];
+    while (s.nextIrqEdge < s.edgeCount && s.edges[s.nextIrqEdge] <= sim::nowNs)
+        s.nextIrqEdge++;
+    if (!isrs[irq])
+        attached++;
+    isrs[irq] = isr;
+}
+
+void detachInterrupt(int irq)
+{
+    if (irq < 0 || irq >= sim::PINS || !isrs[irq])
+        return;
+    isrs[irq] = nullptr;
+    attached--;
+}
+
+void noInterrupts()
+{
+    irqDisabled = true;
+}
+
+void interrupts()
+{
+    irqDisabled = false;
+    fireEdges(sim::nowNs); // Edges latched while disabled
+}
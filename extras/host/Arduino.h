@@ -0,0 +1,133 @@
+#ifndef MYDHT_HOST_ARDUINO_H
+#define MYDHT_HOST_ARDUINO_H
+
+/*
+  Host (Linux) stand-in for the Arduino core, just the part of the API that src/ uses.
+
+  Time is virtual: micros(), millis(), delay() and delayMicroseconds() read and advance
+  sim::nowNs (see dht_sim.h), and every micros(), digitalRead() and pin call also costs a
+  configurable number of nanoseconds, so timing loops behave as on a slow MCU. Pins read the
+  simulated DHT line of the same number; interrupts attached with attachInterrupt() fire at the
+  virtual time of each line edge.
+
+  ARDUINO is left undefined, so src/ builds its host variants (digitalRead() pins, DHTService on
+  std::thread). Built with MYDHT_HOST_PORTS defined (make PORTS=1), the core also has port input
+  registers, and src/ uses its register pin backend and MultiDHTManager group reads instead.
+*/
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <math.h>
+
+typedef uint8_t byte;
+
+#define HIGH 0x1
+#define LOW 0x0
+
+#define INPUT 0x0
+#define OUTPUT 0x1
+#define INPUT_PULLUP 0x2
+
+#define CHANGE 1
+#define FALLING 2
+#define RISING 3
+#define NOT_AN_INTERRUPT -1
+
+#define DEC 10
+#define HEX 16
+
+// No separate flash address space on a host
+#define PROGMEM
+#define F(s) (s)
+#define pgm_read_byte(p) (*(const uint8_t *)(p))
+#define pgm_read_word(p) (*(const uint16_t *)(p))
+#define pgm_read_dword(p) (*(const uint32_t *)(p))
+#define pgm_read_float(p) (*(const float *)(p))
+
+// Time
+unsigned long micros();
+unsigned long millis();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+inline void yield() {}
+
+// Pins
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t val);
+int digitalRead(uint8_t pin);
+
+#if defined(MYDHT_HOST_PORTS)
+// Port input registers, 8 pins per port like AVR: pin p is bit p % 8 of port p / 8. The registers
+// follow the simulated lines as virtual time advances, and a load costs no virtual time.
+inline uint8_t digitalPinToPort(uint8_t pin) { return pin / 8; }
+inline uint32_t digitalPinToBitMask(uint8_t pin) { return 1u << (pin % 8); }
+const volatile uint32_t *portInputRegister(uint8_t port);
+#endif
+
+// Interrupts: every pin has one, numbered like the pin
+inline int digitalPinToInterrupt(uint8_t pin) { return pin; }
+void attachInterrupt(int irq, void (*isr)(), int mode);
+void detachInterrupt(int irq);
+void noInterrupts();
+void interrupts();
+
+class Print
+{
+public:
+  virtual ~Print() {}
+  virtual size_t write(uint8_t c) = 0;
+  virtual size_t write(const uint8_t *buf, size_t len)
+  {
+    size_t n = 0;
+    while (len--)
+      n += write(*buf++);
+    return n;
+  }
+
+  size_t print(const char *s) { return write((const uint8_t *)s, strlen(s)); }
+  size_t print(char c) { return write((uint8_t)c); }
+  size_t print(unsigned char v, int base = DEC) { return print((unsigned long)v, base); }
+  size_t print(int v, int base = DEC) { return print((long)v, base); }
+  size_t print(unsigned int v, int base = DEC) { return print((unsigned long)v, base); }
+  size_t print(long v, int base = DEC)
+  {
+    char buf[24];
+    snprintf(buf, sizeof(buf), base == HEX ? "%lX" : "%ld", v);
+    return print(buf);
+  }
+  size_t print(unsigned long v, int base = DEC)
+  {
+    char buf[24];
+    snprintf(buf, sizeof(buf), base == HEX ? "%lX" : "%lu", v);
+    return print(buf);
+  }
+  size_t print(double v, int digits = 2)
+  {
+    char buf[48];
+    snprintf(buf, sizeof(buf), "%.*f", digits, v);
+    return print(buf);
+  }
+
+  size_t println() { return print("\n"); }
+  template <typename T>
+  size_t println(T v) { return print(v) + println(); }
+  template <typename T>
+  size_t println(T v, int format) { return print(v, format) + println(); }
+};
+
+// Serial goes to stdout
+class HardwareSerial : public Print
+{
+public:
+  void begin(unsigned long) {}
+  operator bool() const { return true; }
+  using Print::write;
+  size_t write(uint8_t c) override { return fwrite(&c, 1, 1, stdout); }
+};
+
+extern HardwareSerial Serial;
+
+#endif
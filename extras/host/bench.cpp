@@ -0,0 +1,159 @@
+/*
+  bench: baseline cost of the driver's read paths on the simulated DHT line.
+
+  Usage:  bench [reads] [jitterNs]      (default: 2000 reads, no jitter)
+
+  For each case it prints two costs per call:
+    virtual  time the call keeps the (simulated) MCU busy, from sim::nowNs; with the default
+             call costs this is close to a 16 MHz AVR
+    host     wall-clock time on this machine, simulator included: compare it between builds
+             of the driver, not with hardware
+
+  Cases, for a DHT22 and a DHT11:
+    read()            one good frame; a single attempt, so this is readOnce() plus bookkeeping
+    read() no sensor  the full failure path (every retry times out)
+    getData()         read() plus conversion and dew point / heat index
+    processAsync()    one edge-driven async read: per call (mean and longest) and in total;
+                      the loop calls it every 100 us of virtual time
+
+  Built with the library by the Makefile in this folder (make -C extras/host).
+*/
+
+#include "Arduino.h"
+#include "dht_sim.h"
+#include "myDHTPro.h"
+#include <chrono>
+
+namespace
+{
+    const uint8_t PIN = 2;
+    const uint64_t LOOP_GAP_NS = 100000; // Async: time between two processAsync() calls
+    const uint64_t IDLE_NS = 3000000000ull; // Between reads: longer than any minimum interval
+
+    struct Cost
+    {
+        uint64_t virtualNs = 0;
+        uint64_t hostNs = 0;
+        unsigned long calls = 0;
+        unsigned long failures = 0;
+    };
+
+    uint64_t hostNow()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   std::chrono::steady_clock::now().time_since_epoch())
+            .count();
+    }
+
+    void report(const char *name, const Cost &c)
+    {
+        printf("  %-22s virtual %9.1f us   host %8.0f ns   failed %lu/%lu\n", name,
+               c.calls ? c.virtualNs / 1000.0 / c.calls : 0.0, c.calls ? (double)c.hostNs / c.calls : 0.0,
+               c.failures, c.calls);
+    }
+
+    // Times fn() once per read, with idle time in between
+    template <typename F>
+    Cost measure(unsigned long reads, F fn)
+    {
+        Cost c;
+        for (unsigned long i = 0; i < reads; i++)
+        {
+            sim::advanceNs(IDLE_NS);
+            uint64_t v0 = sim::nowNs;
+            uint64_t h0 = hostNow();
+            bool ok = fn();
+            c.hostNs += hostNow() - h0;
+            c.virtualNs += sim::nowNs - v0;
+            c.calls++;
+            if (!ok)
+                c.failures++;
+        }
+        return c;
+    }
+
+    bool asyncDone = false;
+    DHTError asyncStatus = DHT_OK;
+
+    void onAsync(DHTData data)
+    {
+        asyncDone = true;
+        asyncStatus = data.status;
+    }
+
+    void benchAsync(MyDHT &sensor, unsigned long reads)
+    {
+        Cost perCall, total;
+        uint64_t longestNs = 0;
+
+        for (unsigned long i = 0; i < reads; i++)
+        {
+            sim::advanceNs(IDLE_NS);
+            asyncDone = false;
+            uint64_t start = sim::nowNs;
+            sensor.startAsyncRead(onAsync);
+
+            while (!asyncDone)
+            {
+                uint64_t v0 = sim::nowNs;
+                uint64_t h0 = hostNow();
+                sensor.processAsync();
+                perCall.hostNs += hostNow() - h0;
+                uint64_t stepNs = sim::nowNs - v0;
+                perCall.virtualNs += stepNs;
+                perCall.calls++;
+                if (stepNs > longestNs)
+                    longestNs = stepNs;
+                sim::advanceNs(LOOP_GAP_NS);
+            }
+
+            total.virtualNs += sim::nowNs - start;
+            total.calls++;
+            if (asyncStatus != DHT_OK)
+                total.failures++;
+        }
+        printf("  %-22s virtual %9.1f us   host %8.0f ns   longest %.1f us\n", "processAsync() / call",
+               perCall.virtualNs / 1000.0 / perCall.calls, (double)perCall.hostNs / perCall.calls, longestNs / 1000.0);
+        printf("  %-22s %.1f calls and %.2f ms   failed %lu/%lu\n", "processAsync() / read",
+               (double)perCall.calls / total.calls, total.virtualNs / 1e6 / total.calls, total.failures, total.calls);
+    }
+
+    void benchType(DHTType type, unsigned long reads)
+    {
+        sim::Sensor &line = sim::sensors[PIN];
+        if (type == DHT22)
+            line.setDHT22(55.5f, 23.4f);
+        else
+            line.setDHT11(48, 23, 0);
+
+        MyDHT sensor(PIN, type);
+        sensor.begin();
+        sensor.setRetries(1);
+
+        printf("%s\n", type == DHT22 ? "DHT22" : "DHT11");
+        report("read()", measure(reads, [&] { return sensor.read() == DHT_OK; }));
+        report("getData()", measure(reads, [&] { return sensor.getData().status == DHT_OK; }));
+        benchAsync(sensor, reads);
+
+        line.present = false;
+        sensor.setRetries(3);
+        report("read() no sensor", measure(reads / 10 + 1, [&] { return sensor.read() == DHT_OK; }));
+        line.present = true;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    unsigned long reads = argc > 1 ? strtoul(argv[1], nullptr, 10) : 2000;
+    uint32_t jitterNs = argc > 2 ? strtoul(argv[2], nullptr, 10) : 0;
+
+    sim::reset();
+    sim::sensors[PIN].jitterNs = jitterNs;
+    srand(1);
+
+    printf("call costs: micros() %u ns, digitalRead() %u ns, pin writes %u ns; jitter +-%u ns\n",
+           sim::microsCostNs, sim::readCostNs, sim::pinCostNs, jitterNs);
+    benchType(DHT22, reads);
+    benchType(DHT11, reads);
+    return 0;
+}
@@ -0,0 +1,82 @@
+#include "dht_sim.h"
+#include <stdlib.h>
+#include <math.h>
+
+namespace
+{
+    constexpr int32_t RESPONSE_DELAY_NS = 30000; // Release to the sensor pulling LOW
+    constexpr int32_t ACK_LOW_NS = 80000;
+    constexpr int32_t ACK_HIGH_NS = 80000;
+    constexpr int32_t BIT_LOW_NS = 50000;
+    constexpr int32_t ZERO_HIGH_NS = 26000;
+    constexpr int32_t ONE_HIGH_NS = 70000;
+    constexpr int32_t END_LOW_NS = 50000;
+}
+
+void sim::Sensor::setBytes(uint8_t b0, uint8_t b1, uint8_t b2, uint8_t b3)
+{
+    frame[0] = b0;
+    frame[1] = b1;
+    frame[2] = b2;
+    frame[3] = b3;
+    frame[4] = (uint8_t)(b0 + b1 + b2 + b3);
+}
+
+void sim::Sensor::setDHT22(float humidity, float tempC)
+{
+    uint16_t h = (uint16_t)lroundf(humidity * 10);
+    long t10 = lroundf(tempC * 10);
+    uint16_t t = (t10 < 0) ? (uint16_t)(0x8000 | -t10) : (uint16_t)t10;
+    setBytes(h >> 8, h & 0xFF, t >> 8, t & 0xFF);
+    minStartNs = 1000000;
+}
+
+void sim::Sensor::setDHT11(uint8_t humidity, uint8_t tempC, uint8_t tempTenths)
+{
+    setBytes(humidity, 0, tempC, tempTenths);
+    minStartNs = 18000000;
+}
+
+int32_t sim::Sensor::jitter()
+{
+    return jitterNs ? (int32_t)(rand() % (2 * jitterNs + 1)) - (int32_t)jitterNs : 0;
+}
+
+/*
+  Lays out the edges of one response, starting releaseNs (the driver switching the line to input)
+*/
+void sim::Sensor::trigger(uint64_t releaseNs)
+{
+    uint64_t t = releaseNs + RESPONSE_DELAY_NS;
+    edgeCount = 0;
+    nextIrqEdge = 0;
+
+    edges[edgeCount++] = t; // Sensor pulls LOW
+    t += ACK_LOW_NS + jitter();
+    edges[edgeCount++] = t;
+    t += ACK_HIGH_NS + jitter();
+
+    for (uint8_t i = 0; i < 40; i++)
+    {
+        bool one = (frame[i / 8] >> (7 - i % 8)) & 1;
+        edges[edgeCount++] = t; // Bit LOW starts
+        t += BIT_LOW_NS - highSkewNs + jitter();
+        edges[edgeCount++] = t; // Bit HIGH starts
+        t += (one ? ONE_HIGH_NS : ZERO_HIGH_NS) + highSkewNs + jitter();
+    }
+
+    edges[edgeCount++] = t; // End of frame LOW
+    t += END_LOW_NS;
+    edges[edgeCount++] = t; // Released
+
+    transactions++;
+}
+
+// The line idles HIGH and toggles at every edge
+int sim::Sensor::level(uint64_t atNs) const
+{
+    int lvl = 1;
+    for (uint8_t i = 0; i < edgeCount && edges[i] <= atNs; i++)
+        lvl ^= 1;
+    return lvl;
+}
@@ -0,0 +1,72 @@
+#ifndef MYDHT_HOST_DHT_SIM_H
+#define MYDHT_HOST_DHT_SIM_H
+
+/*
+  Virtual clock and simulated DHT11 / DHT22 data lines behind the host Arduino.h.
+
+  Every pin has a Sensor. When the driver releases the line after a start pulse of at least
+  minStartNs, the sensor answers with datasheet timing (DHT11 and DHT22 use the same):
+    20-40 us     line still HIGH (30 us here)
+    80 us LOW, 80 us HIGH        acknowledge
+    40 x (50 us LOW, 26 / 70 us HIGH)   bits, MSB first, HIGH length 26 us = 0, 70 us = 1
+    50 us LOW    end of frame, then the pull-up takes the line HIGH
+  digitalRead() returns the level at the current virtual time, and an interrupt attached to the
+  pin fires at the time of each edge.
+
+  Costs of the API calls are charged to the clock (defaults close to a 16 MHz AVR), so blocking
+  loops see a slow CPU: set them to 0 to time the logic alone.
+*/
+
+#include <stdint.h>
+#include <atomic>
+
+namespace sim
+{
+  constexpr uint8_t PINS = 32;
+  constexpr uint8_t FRAME_EDGES = 84; // 2 ACK edges + 80 bit edges + start and end of frame
+
+  extern std::atomic<uint64_t> nowNs; // Virtual time, ns; change it with advanceNs()
+
+  extern uint32_t microsCostNs; // Charged per micros() / millis() call (default 3500)
+  extern uint32_t readCostNs;   // Per digitalRead() (default 3000)
+  extern uint32_t pinCostNs;    // Per pinMode() / digitalWrite() (default 4000)
+
+  extern unsigned long microsCalls; // micros() calls so far
+  extern unsigned long readCalls;   // digitalRead() calls so far
+
+  // Advances virtual time, running the interrupts of the edges on the way (unless disabled)
+  void advanceNs(uint64_t ns);
+
+  struct Sensor
+  {
+    bool present = true;                                // false: never answers
+    uint8_t frame[5] = {0x02, 0x8C, 0x01, 0x0E, 0x9D};  // Next frame sent (DHT22 65.2 %RH, 27.0 °C)
+    uint32_t minStartNs = 1000000;                      // Shortest start pulse answered (DHT22 1 ms, DHT11 18 ms)
+    uint32_t jitterNs = 0;                              // Every pulse length varies by up to +-jitterNs
+    int32_t highSkewNs = 0;                             // Added to every bit HIGH, taken from the LOW before it
+    unsigned long transactions = 0;                     // Frames sent
+
+    // Frame contents, checksum included
+    void setBytes(uint8_t b0, uint8_t b1, uint8_t b2, uint8_t b3);
+    void setDHT22(float humidity, float tempC); // Also sets minStartNs to 1 ms
+    void setDHT11(uint8_t humidity, uint8_t tempC, uint8_t tempTenths = 0); // 18 ms
+
+    // Used by the Arduino.h implementation
+    void trigger(uint64_t releaseNs);
+    int level(uint64_t atNs) const;
+
+    uint64_t edges[FRAME_EDGES]; // Times of the line edges of the current frame
+    uint8_t edgeCount = 0;
+    uint8_t nextIrqEdge = 0;     // First edge whose interrupt has not run yet
+
+  private:
+    int32_t jitter();
+  };
+
+  extern Sensor sensors[PINS];
+
+  // Resets clock, counters, pins, interrupts and sensors to their defaults
+  void reset();
+}
+
+#endif
@@ -1,25 +1,258 @@
 #include "MultiDHTManager.h"
+#include "myDHT_protocol.h"
 
-MultiDHTManager::MultiDHTManager() : count(0) {}
-
-void MultiDHTManager::addSensor(MyDHT &sensor)
+void MultiDHTManagerBase::addSensor(MyDHT &sensor)
 {
-    if (count < MAX_SENSORS)
+    if (count < capacity)
     {
         sensors[count++] = &sensor;
     }
 }
 
-int MultiDHTManager::readAll(DHTResult results[])
+void MultiDHTManagerBase::setQueue(DHTQueueBase *queue)
+{
+    for (int i = 0; i < count; i++)
+        sensors[i]->setQueue(queue);
+}
+
+void MultiDHTManagerBase::beginAsync()
 {
+    for (int i = 0; i < count; i++)
+        sensors[i]->beginAsync(nullptr);
+}
+
+bool MultiDHTManagerBase::processAsync()
+{
+    bool running = false;
     for (int i = 0; i < count; i++)
     {
-        DHTError err = sensors[i]->readSafe();
+        sensors[i]->processAsync();
+        if (sensors[i]->isReading())
+            running = true;
+    }
+    return running;
+}
+
+int MultiDHTManagerBase::readAll(DHTResult results[])
+{
+#if defined(DHT_PIN_REGISTER_BACKEND)
+    if (groupRead)
+    {
+        readGroups(results);
+        return count;
+    }
+#endif
 
-        results[i].pin = sensors[i]->getPin();
-        results[i].temperature = (err == DHT_OK) ? sensors[i]->getTemperature(Celsius) : NAN;
-        results[i].humidity = (err == DHT_OK) ? sensors[i]->getHumidity() : NAN;
-        results[i].error = err;
+    for (int i = 0; i < count; i++)
+    {
+        DHTError err = sensors[i]->readSafe();
+        fillResult(i, err, results[i]);
     }
     return count;
-}
\ No newline at end of file
+}
+
+void MultiDHTManagerBase::startSweep(DHTResult results[], DHTResultCallback cb)
+{
+    sweepResults = results;
+    sweepCallback = cb;
+
+    for (int i = 0; i < count; i++)
+    {
+        results[i].ready = false;
+
+        // Same guard as readSafe(): a sensor read too recently keeps its last result
+        if (!sensors[i]->isReadAllowed())
+            continue;
+
+        sensors[i]->startAsyncRead(nullptr);
+    }
+}
+
+bool MultiDHTManagerBase::processSweep()
+{
+    if (!sweepResults)
+        return false;
+
+    bool running = false;
+    for (int i = 0; i < count; i++)
+    {
+        DHTResult &result = sweepResults[i];
+        if (result.ready)
+            continue;
+
+        sensors[i]->processAsync();
+        if (sensors[i]->isReading())
+        {
+            running = true;
+            continue;
+        }
+
+        fillResult(i, sensors[i]->getLastError(), result);
+        if (sweepCallback)
+            sweepCallback(result);
+    }
+
+    if (!running)
+        sweepResults = nullptr; // All results delivered
+    return running;
+}
+
+void MultiDHTManagerBase::fillResult(int i, DHTError err, DHTResult &result)
+{
+    result.pin = sensors[i]->getPin();
+    result.temperature = (err == DHT_OK) ? sensors[i]->getTemperature(Celsius) : NAN;
+    result.humidity = (err == DHT_OK) ? sensors[i]->getHumidity() : NAN;
+    result.error = err;
+    result.ready = true;
+}
+
+#if DHT_METRICS
+/*
+  Sum of the metrics of all sensors
+*/
+DHTMetrics MultiDHTManagerBase::getMetrics() const
+{
+    DHTMetrics total = {};
+    for (int i = 0; i < count; i++)
+        total.add(sensors[i]->getMetrics());
+    return total;
+}
+
+void MultiDHTManagerBase::resetMetrics()
+{
+    for (int i = 0; i < count; i++)
+        sensors[i]->resetMetrics();
+}
+#endif
+
+#if defined(DHT_PIN_REGISTER_BACKEND)
+/*
+  Splits the sensors into port groups and reads each group with a single capture.
+  results[i].ready marks the sensors already handled.
+*/
+void MultiDHTManagerBase::readGroups(DHTResult results[])
+{
+    for (int i = 0; i < count; i++)
+        results[i].ready = false;
+
+    for (int i = 0; i < count; i++)
+    {
+        if (results[i].ready)
+            continue;
+
+        MyDHT *first = sensors[i];
+        if (first->testMode || first->isReading() || !first->isReadAllowed())
+        {
+            fillResult(i, first->readSafe(), results[i]); // Same rules as the serial readAll()
+            continue;
+        }
+
+        // Collect the other sensors on the same port that are due for a read
+        const volatile mydht::PortReg *port = mydht::DHTPin(first->_pin).port();
+        uint8_t members[DHT_GROUP_MAX_PINS];
+        uint8_t n = 0;
+        members[n++] = i;
+
+        for (int j = i + 1; j < count && n < DHT_GROUP_MAX_PINS; j++)
+        {
+            MyDHT *s = sensors[j];
+            if (!results[j].ready && !s->testMode && !s->isReading() && s->isReadAllowed() &&
+                mydht::DHTPin(s->_pin).port() == port)
+                members[n++] = j;
+        }
+
+        if (n == 1)
+            fillResult(i, first->readSafe(), results[i]); // Nothing to share, keep the normal retry loop
+        else
+            readGroup(members, n, results);
+    }
+}
+
+/*
+  Reads sensors sharing one port: one start signal and one port-sampling capture per attempt.
+  Sensors that fail are captured again, up to their own retry count.
+*/
+void MultiDHTManagerBase::readGroup(const uint8_t *members, uint8_t n, DHTResult results[])
+{
+    // Group timing: the slowest start pulse and longest timeouts of the members
+    DHTTimings t = {0, 0, 0, 0, 0};
+    uint16_t retryDelay = 0;
+    unsigned long now = millis();
+    for (uint8_t k = 0; k < n; k++)
+    {
+        MyDHT *s = sensors[members[k]];
+        const DHTTimings &st = s->_timings;
+        uint16_t sensorDelay = (s->_type == DHT11) ? DHTModel<DHT11>::retryDelayMs : DHTModel<DHT22>::retryDelayMs;
+
+        if (st.startLowMs > t.startLowMs)
+            t.startLowMs = st.startLowMs;
+        if (st.ackTimeoutUs > t.ackTimeoutUs)
+            t.ackTimeoutUs = st.ackTimeoutUs;
+        if (st.bitTimeoutUs > t.bitTimeoutUs)
+            t.bitTimeoutUs = st.bitTimeoutUs;
+        if (sensorDelay > retryDelay)
+            retryDelay = sensorDelay;
+        s->_lastReadMs = now; // Counts for the readSafe() interval
+    }
+
+    const volatile mydht::PortReg *port = mydht::DHTPin(sensors[members[0]]->_pin).port();
+    unsigned long startUs = sensors[members[0]]->metricsClock();
+
+    for (uint8_t attempt = 0;; attempt++)
+    {
+        // Pending members of this attempt
+        uint8_t idx[DHT_GROUP_MAX_PINS];
+        uint8_t pins[DHT_GROUP_MAX_PINS];
+        mydht::PortReg masks[DHT_GROUP_MAX_PINS];
+        uint8_t *highTimes[DHT_GROUP_MAX_PINS];
+        uint8_t *lowTimes[DHT_GROUP_MAX_PINS];
+        DHTError errors[DHT_GROUP_MAX_PINS];
+        uint8_t m = 0;
+
+        for (uint8_t k = 0; k < n; k++)
+        {
+            MyDHT *s = sensors[members[k]];
+            if (results[members[k]].ready)
+                continue;
+
+            idx[m] = members[k];
+            pins[m] = s->_pin;
+            masks[m] = mydht::DHTPin(s->_pin).mask();
+            highTimes[m] = s->_highTimes;
+            lowTimes[m] = s->_lowTimes;
+            m++;
+        }
+
+        if (m == 0)
+            break;
+        if (attempt > 0)
+            delay(retryDelay); // Short delay before retry
+
+        mydht::sendGroupStartSignal(pins, m, t.startLowMs);
+        mydht::captureGroup(mydht::RegisterPort(port), masks, m, t, highTimes, lowTimes, errors);
+
+        /*
+          Decoded per sensor on purpose. captureGroup() stores per-line durations rather than raw
+          port snapshots, so a bit-sliced decoder (one bit lane per sensor) has to classify every
+          bit into a plane and unpack it again. extras/dhtgroup benchmarks that prototype against
+          decodeFrame(): slower per sensor at every group size from 1 to 32 lines on the host,
+          and AVR has no barrel shifter for the unpack.
+        */
+        for (uint8_t k = 0; k < m; k++)
+        {
+            MyDHT *s = sensors[idx[k]];
+            DHTError err = (errors[k] == DHT_OK) ? s->decodeCapture() : errors[k];
+            s->metricsAttempt(err);
+
+            // Like read(): retry capture failures, report sanity results right away
+            if (err == DHT_OK || attempt + 1 >= s->_retries)
+            {
+                DHTError result = s->finishRead(err);
+                s->metricsRead(startUs, attempt + 1, result, true); // Shared capture time counts for every member
+                s->publish(result);
+                fillResult(idx[k], result, results[idx[k]]);
+            }
+        }
+    }
+}
+#endif
@@ -3,6 +3,7 @@
 
 #include "myDHTPro.h"
 
+// Default capacity of MultiDHTManager<>; give another N for more or fewer sensors
 #define MAX_SENSORS 8
 
 struct DHTResult
@@ -11,19 +12,92 @@ struct DHTResult
     float temperature;
     float humidity;
     DHTError error;
+    bool ready; // true once this entry holds the result of the current sweep
 };
 
-class MultiDHTManager
+// Called by processSweep() as each sensor's result arrives
+typedef void (*DHTResultCallback)(const DHTResult &result);
+
+/*
+  Storage comes from MultiDHTManager<N>, this base class holds the shared code. Functions that
+  work with any manager (DHTLogEncoder::writeSweep() for example) take a MultiDHTManagerBase &.
+*/
+class MultiDHTManagerBase
 {
 public:
-    MultiDHTManager();
-
     void addSensor(MyDHT &sensor);
+
+    /*
+      Starts every sensor with MyDHT::beginAsync(): the power-up waits and type detections run
+      side by side, so N sensors are ready after about one begin() instead of N.
+    */
+    void beginAsync();
+    bool processAsync(); // Advances every sensor's async state machine; true while any is busy
     int readAll(DHTResult results[]); // returns number of sensors read
 
+    /*
+      Group-read mode for readAll(): sensors on the same GPIO port get one shared start signal
+      and are captured together by sampling the port register, so N sensors on a port cost about
+      one transaction. Needs the register pin backend (DHT_FAST_GPIO); otherwise readAll() stays serial.
+    */
+    void setGroupRead(bool enable) { groupRead = enable; }
+
+    /*
+      Attaches one queue to every sensor added so far. readAll(), sweeps and processAsync() all
+      complete in the caller's context, so the sensors together stay a single producer.
+    */
+    void setQueue(DHTQueueBase *queue);
+    int getCount() const { return count; }
+    uint8_t getCapacity() const { return capacity; }
+    MyDHT *getSensor(int i) const { return sensors[i]; } // Sensor behind results[i]
+
+#if DHT_METRICS
+    DHTMetrics getMetrics() const; // Aggregate of all sensors (group reads count their shared time per member)
+    void resetMetrics();
+#endif
+
+    /*
+      Non-blocking sweep: starts an async read on every sensor at once, so the start pulses,
+      ACKs and bit transfers overlap and a sweep costs about one transaction instead of N.
+      @param results Caller storage for getCount() entries, filled as sensors complete
+      @param cb      Optional callback for each completed result
+    */
+    void startSweep(DHTResult results[], DHTResultCallback cb = nullptr);
+    bool processSweep();             // Call repeatedly from loop(); returns true while the sweep is running
+    bool isSweeping() const { return sweepResults != nullptr; }
+
+protected:
+    MultiDHTManagerBase(MyDHT **storage, uint8_t capacity) : sensors(storage), capacity(capacity), count(0) {}
+
 private:
-    MyDHT *sensors[MAX_SENSORS];
+    MyDHT **sensors;
+    uint8_t capacity;
     int count;
+
+    DHTResult *sweepResults = nullptr;     // Results of the running sweep, nullptr when idle
+    DHTResultCallback sweepCallback = nullptr;
+
+    bool groupRead = false;
+
+    void fillResult(int i, DHTError err, DHTResult &result);
+    void readGroups(DHTResult results[]);                                   // readAll() in group-read mode
+    void readGroup(const uint8_t *members, uint8_t n, DHTResult results[]); // One shared capture per attempt
+};
+
+/*
+  Manager for up to N sensors, N pointers of sensor table and nothing else.
+  MultiDHTManager<> holds MAX_SENSORS.
+*/
+template <uint8_t N = MAX_SENSORS>
+class MultiDHTManager : public MultiDHTManagerBase
+{
+    static_assert(N >= 1, "MultiDHTManager must hold at least one sensor");
+
+public:
+    MultiDHTManager() : MultiDHTManagerBase(storage, N) {}
+
+private:
+    MyDHT *storage[N];
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,177 @@
+#ifndef MYDHTTYPED_H
+#define MYDHTTYPED_H
+
+#include "myDHTPro.h"
+#include "myDHT_protocol.h"
+
+/*
+  Compile-time specialized sensor: MyDHTTyped<DHT11> or MyDHTTyped<DHT22>.
+
+  Timings, decode formulas and plausible ranges come from DHTModel<T> as constants,
+  so there is no runtime type switch and no DHTTimings storage.
+  Use MyDHT (with DHT_AUTO) when the model is only known at runtime.
+
+  Lean by design: no debug/test mode, no async API and no last-valid-data fallback.
+*/
+template <DHTType T>
+class MyDHTTyped
+{
+public:
+  typedef DHTModel<T> Model;
+
+  /*
+    Constructor
+    @param pin     Arduino pin number
+    @param retries Number of retry attempts if read fails (default 3)
+  */
+  explicit MyDHTTyped(uint8_t pin, uint8_t retries = 3) : _pin(pin), _retries(retries) {}
+
+  // Initialize the sensor (set pin mode, wait for stabilization)
+  void begin()
+  {
+    pinMode(_pin, INPUT_PULLUP);
+    delay(3000); // Delay for sensor stabilization
+    _lastReadMs = 0;
+  }
+
+  // Read new data from sensor with retries, returns DHTError
+  DHTError read()
+  {
+    DHTError err = DHT_ERROR_INTERNAL;
+    for (uint8_t attempt = 0; attempt < _retries; attempt++)
+    {
+      err = readOnce();
+      if (err == DHT_OK)
+      {
+        err = sanityCheck() ? DHT_OK : DHT_ERROR_SANITY;
+        break;
+      }
+      delay(Model::retryDelayMs); // Short delay before retry
+    }
+
+    setError(err);
+    return err;
+  }
+
+  // Safe read: enforces getMinReadInterval() timing
+  DHTError readSafe()
+  {
+    unsigned long now = millis();
+    if (_lastReadMs != 0 && (now - _lastReadMs) < Model::minReadIntervalMs)
+      return _lastError; // Too soon: do not read again
+
+    _lastReadMs = now;
+    return read();
+  }
+
+  // Returns last read temperature
+  float getTemperature(TempUnit unit = Celsius) const
+  {
+    return mydht::fromCelsius(Model::temperatureC(_bytes) + _tempOffsetC, unit);
+  }
+
+  // Returns last relative humidity in %, clamped to 0–100%
+  float getHumidity() const
+  {
+    float hum = Model::humidity(_bytes) + _humidityOffset;
+    if (hum < 0.0)
+      hum = 0.0;
+    if (hum > 100.0)
+      hum = 100.0;
+    return hum;
+  }
+
+  // Dew point (Magnus formula)
+  float getDewPoint(TempUnit unit = Celsius) const
+  {
+    return mydht::fromCelsius(mydht::dewPointC(getTemperature(Celsius), getHumidity()), unit);
+  }
+
+  // Heat index (Rothfusz regression)
+  float getHeatIndex(TempUnit unit = Celsius) const
+  {
+    return mydht::fromFahrenheit(mydht::heatIndexF(getTemperature(Fahrenheit), getHumidity()), unit);
+  }
+
+  // Reads the sensor and returns a data package (NaN values on error); derived = false skips dew point and heat index
+  DHTData getData(TempUnit unit = Celsius, bool derived = true)
+  {
+    DHTData data;
+    data.status = read();
+    if (data.status != DHT_OK)
+    {
+      data.temp = NAN;
+      data.hum = NAN;
+      data.dew = NAN;
+      data.hi = NAN;
+      return data;
+    }
+    return makeData(unit, derived);
+  }
+
+  // Creates a DHTData struct from the last read bytes
+  DHTData makeData(TempUnit unit = Celsius, bool derived = true) const
+  {
+    DHTData d;
+    d.temp = getTemperature(unit);
+    d.hum = getHumidity();
+    d.dew = derived ? getDewPoint(unit) : NAN;
+    d.hi = derived ? getHeatIndex(unit) : NAN;
+    d.status = DHT_OK;
+    return d;
+  }
+
+  // Adjust calibration offset
+  void setTemperatureOffset(float offsetC) { _tempOffsetC = offsetC; }
+  void setHumidityOffset(float offset) { _humidityOffset = offset; }
+  void setRetries(uint8_t retries) { _retries = retries; }
+
+  static constexpr DHTType getType() { return T; }
+  static constexpr uint16_t getMinReadInterval() { return Model::minReadIntervalMs; }
+
+  int getPin() const { return _pin; }
+  DHTError getLastError() const { return _lastError; }
+  uint16_t getFailureCount() const { return _failureCount; }
+  bool isConnected() const { return _failureCount < 5; }
+
+private:
+  uint8_t _pin;
+  uint8_t _retries;
+  float _tempOffsetC = 0.0;
+  float _humidityOffset = 0.0;
+
+  uint8_t _bytes[5] = {0, 0, 0, 0, 0};
+  uint8_t _highTimes[40]; // µs, saturated at 255
+  uint8_t _lowTimes[40];
+
+  DHTError _lastError = DHT_OK;
+  uint16_t _failureCount = 0;
+  unsigned long _lastReadMs = 0;
+
+  // Performs a single read attempt (start signal, ACK, 40 bits, checksum)
+  DHTError readOnce()
+  {
+    mydht::sendStartSignal(_pin, Model::startLowMs);
+
+    DHTError err = mydht::captureFrame(mydht::DHTPin(_pin), Model(), _highTimes, _lowTimes);
+    if (err != DHT_OK)
+      return err;
+
+    mydht::decodeFrame(Model(), _highTimes, _bytes);
+    return mydht::checksumOk(_bytes) ? DHT_OK : DHT_ERROR_CHECKSUM;
+  }
+
+  // Checks if reading is within the model's plausible range (integer tenths, no float math)
+  bool sanityCheck() const { return mydht::plausible<T>(_bytes); }
+
+  void setError(DHTError err)
+  {
+    _lastError = err;
+    if (err != DHT_OK)
+      _failureCount++;
+    else
+      _failureCount = 0;
+  }
+};
+
+#endif
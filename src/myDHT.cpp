@@ -86,24 +86,7 @@ float myDHT::dewPoint(TempUnit unit)
     if (!_readSensor())
         return NAN;
 
-    double T = _lastTemp;
-    double RH = _lastHum;
-    double a = 17.27;
-    double b = 237.7;
-    double alpha = ((a * T) / (b + T)) + log(RH / 100.0);
-    double dewC = (b * alpha) / (a - alpha);
-
-    switch (unit)
-    {
-    case Celsius:
-        return dewC;
-    case Fahrenheit:
-        return dewC * 9.0 / 5.0 + 32;
-    case Kelvin:
-        return dewC + 273.15;
-    default:
-        return dewC;
-    }
+    return mydht::fromCelsius(mydht::dewPointC(_lastTemp, _lastHum), unit);
 }
 
 // Calculate heat index
@@ -113,26 +96,7 @@ float myDHT::HiIndex(TempUnit unit)
         return NAN;
 
     float T = _lastTemp * 9.0 / 5.0 + 32; // Fahrenheit
-    float RH = _lastHum;
-
-    float HI = 0.5 * (T + 61.0 + ((T - 68.0) * 1.2) + (RH * 0.094));
-    if (HI >= 80.0)
-    {
-        // Rothfusz regression
-        HI = -42.379 + 2.04901523 * T + 10.14333127 * RH - 0.22475541 * T * RH - 0.00683783 * T * T - 0.05481717 * RH * RH + 0.00122874 * T * T * RH + 0.00085282 * T * RH * RH - 0.00000199 * T * T * RH * RH;
-    }
-
-    switch (unit)
-    {
-    case Celsius:
-        return (HI - 32) * 5.0 / 9.0;
-    case Fahrenheit:
-        return HI;
-    case Kelvin:
-        return (HI - 32) * 5.0 / 9.0 + 273.15;
-    default:
-        return (HI - 32) * 5.0 / 9.0;
-    }
+    return mydht::fromFahrenheit(mydht::heatIndexF(T, _lastHum), unit);
 }
 
 // Return sensor type
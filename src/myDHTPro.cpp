@@ -7,7 +7,15 @@
 */
 
 #include "myDHTPro.h"
+#include "myDHT_protocol.h"
+#include "myDHT_profile.h"
 #include <math.h>
+#include <string.h>
+
+namespace
+{
+    const uint16_t STARTUP_MS = 3000; // Sensor stabilization after power-up
+}
 
 /*
   Constructor
@@ -23,30 +31,15 @@ MyDHT::MyDHT(uint8_t pin, DHTType type, uint8_t retries)
 
     switch (_type)
     {
-    case DHT11:
-        _timings.startLowMs = 18;      // Pull LOW duration in ms
-        _timings.ackTimeoutUs = 5000;  // ACK timeout in µs
-        _timings.ackDoneUs = 80;       // ACK done threshold
-        _timings.bitTimeoutUs = 120;   // Bit read timeout
-        _timings.highThresholdUs = 50; // HIGH pulse threshold to distinguish 0/1
-        break;
-
     case DHT22:
-        _timings.startLowMs = 2;      // Pull LOW duration in ms
-        _timings.ackTimeoutUs = 3000; // ACK timeout in µs
-        _timings.ackDoneUs = 80;
-        _timings.bitTimeoutUs = 200;
-        _timings.highThresholdUs = 40;
+        _timings = DHTModel<DHT22>::timings();
         break;
 
+    case DHT11:
     case DHT_AUTO:
     default:
-        // Default safe timings for autodetect
-        _timings.startLowMs = 18;
-        _timings.ackTimeoutUs = 5000;
-        _timings.ackDoneUs = 80;
-        _timings.bitTimeoutUs = 120;
-        _timings.highThresholdUs = 50;
+        // DHT11 timings are also the safe default for autodetect
+        _timings = DHTModel<DHT11>::timings();
         break;
     }
 
@@ -63,7 +56,7 @@ void MyDHT::begin()
     pinMode(_pin, INPUT_PULLUP);
 
     // Delay for sensor stabilization
-    delay(3000);
+    delay(startupDelayMs());
 
     if (_type == DHT_AUTO)
     {
@@ -76,6 +69,47 @@ void MyDHT::begin()
     _lastReadMs = 0;
 }
 
+/*
+  Non-blocking begin(): schedules the first read after the stabilization time instead of
+  waiting for it. With DHT_AUTO the model is detected from that read's frame (finishAsync()).
+*/
+void MyDHT::beginAsync(DHTCallback cb)
+{
+    detachEdgeCapture();
+    pinMode(_pin, INPUT_PULLUP);
+
+    _hasLastValidData = false;
+    _lastReadMs = 0;
+
+    _callback = cb;
+    _contextCallback = nullptr;
+    _asyncAttempt = 0;
+    _starting = true;
+
+    _scheduledMs = millis() + startupDelayMs();
+    _state = SCHEDULED;
+}
+
+bool MyDHT::begin(DHTProfileStorage &storage, uint16_t address)
+{
+    bool loaded = loadProfile(storage, address);
+    begin();
+
+    if (!loaded && _type != DHT_AUTO)
+        saveProfile(storage, address); // Warm start on the next boot
+    return loaded;
+}
+
+/*
+  Stabilization wait before the first read. A sensor restored from a profile is known to work
+  (typically a reboot after a brownout), so only the minimum read interval is respected;
+  it also covers the datasheet power-up time (1 s DHT11, 2 s DHT22).
+*/
+uint16_t MyDHT::startupDelayMs() const
+{
+    return _profileLoaded ? getMinReadInterval() : STARTUP_MS;
+}
+
 /*
   Read sensor data with retry mechanism
   @return DHTError code
@@ -86,76 +120,142 @@ DHTError MyDHT::read()
     if constexpr (mydht::optimizedBuild())
     {
         // Memory-light verzija: preskačemo debug i testMode
-        DHTError err = readOnce();
-        if (err != DHT_OK)
-        {
-            setError(err);
-            return err;
-        }
-
-        if (!sanityCheck())
-        {
-            setError(DHT_ERROR_SANITY);
-            return DHT_ERROR_SANITY;
-        }
-        setError(DHT_OK);
-        _hasLastValidData = true;
-        return DHT_OK;
+        unsigned long startUs = metricsClock();
+        DHTError result = finishRead(readOnce());
+        metricsRead(startUs, 1, result, true);
+        publish(result);
+        return result;
     }
     else
     {
         // test mode
         if (testMode)
         {
+            if (_type == DHT_AUTO)
+                detectFromFrame();
             if (!sanityCheck()) // check simulated bytes
             {
                 setError(DHT_ERROR_SANITY);
+                publish(DHT_ERROR_SANITY);
                 return DHT_ERROR_SANITY;
             }
             _hasLastValidData = true;
             setError(DHT_OK);
+            recordSample();
+            publish(DHT_OK);
             return DHT_OK;
         }
 
-        DHTError err;
-        uint16_t retryDelay = (_type == DHT11) ? 50 : 20;
+        DHTError err = DHT_ERROR_INTERNAL; // Reported as is if setRetries(0) skips every attempt
+        uint16_t retryDelay = (_type == DHT11) ? DHTModel<DHT11>::retryDelayMs : DHTModel<DHT22>::retryDelayMs;
+        unsigned long startUs = metricsClock();
 
         for (uint8_t attempt = 0; attempt < _retries; attempt++)
         {
-
-            if (debugMode)
-                debugPrint("Read attempt %d/%d", attempt + 1, _retries);
+            trace(DHT_TRACE_READ_ATTEMPT, attempt + 1, _retries);
 
             err = readOnce();
             if (err == DHT_OK)
             {
-                // If sanity check fails, report an error but fall back to last valid reading when available
-                if (!sanityCheck())
-                {
-                    setError(DHT_ERROR_SANITY);
-
-                    if (_hasLastValidData)
-                    {
-                        return DHT_OK;
-                    }
-
-                    return DHT_ERROR_SANITY;
-                }
-                setError(DHT_OK);
-                _failureCount = 0;
-                _hasLastValidData = true;
-                return DHT_OK;
+                err = finishRead(err);
+                metricsRead(startUs, attempt + 1, err, true);
+                publish(err);
+                return err;
             }
 
-            if (debugMode)
-                debugPrint("Read result: %s", getErrorString(err));
+            trace(DHT_TRACE_READ_RESULT, err);
 
             delay(retryDelay); // Short delay before retry
         }
 
+        setError(err);
+        metricsRead(startUs, _retries, err, true);
+        publish(err);
+        return err;
+    }
+}
+
+/*
+  Completes a read attempt: sanity check, last-valid fallback and error bookkeeping.
+  Shared by read() and MultiDHTManager group reads.
+  @param err Result of the capture/decode phase
+  @return DHTError code as returned by read()
+*/
+DHTError MyDHT::finishRead(DHTError err)
+{
+    if (err != DHT_OK)
+    {
         setError(err);
         return err;
     }
+
+    if (_type == DHT_AUTO)
+        detectFromFrame(); // First good frame decides the model; if none fits, the sanity check fails
+
+    if (!sanityCheck())
+    {
+        setError(DHT_ERROR_SANITY);
+
+        if constexpr (!mydht::optimizedBuild())
+        {
+            // Report the error but fall back to last valid reading when available
+            if (_hasLastValidData)
+            {
+                metricsSanityFallback();
+                return DHT_OK;
+            }
+        }
+        return DHT_ERROR_SANITY;
+    }
+
+    setError(DHT_OK);
+    _hasLastValidData = true;
+    recordSample();
+    return DHT_OK;
+}
+
+/*
+  Feeds the sample of a successful read to the attached history (calibrated, in tenths)
+*/
+void MyDHT::recordSample()
+{
+    if (_history)
+        _history->add(getTemperatureDeci(Celsius), getHumidityDeci());
+}
+
+/*
+  Counts a completed read and posts it to the attached queue
+  @param result What read() or the async callback reports
+*/
+void MyDHT::publish(DHTError result)
+{
+    _sequence++; // Counts unposted reads too, so a consumer sees the gap
+    if (_queue)
+        _queue->push(makeReading(result));
+}
+
+/*
+  Builds the record of the read that just completed. The values are only filled in when this
+  read itself was good: a sanity failure that read() covers with the last valid data keeps its error.
+*/
+DHTReading MyDHT::makeReading(DHTError result)
+{
+    DHTReading r;
+    r.sensor = this;
+    r.timeMs = millis();
+    r.seq = _sequence;
+    r.status = (result == DHT_OK) ? _lastError : result;
+    if (r.status == DHT_OK)
+    {
+        r.tempC10 = getTemperatureDeci(Celsius);
+        r.hum10 = getHumidityDeci();
+    }
+    else
+    {
+        r.tempC10 = DHT_FIXED_INVALID;
+        r.hum10 = DHT_FIXED_INVALID_HUM;
+    }
+    return r;
 }
 
 /*
@@ -165,78 +265,40 @@ DHTError MyDHT::read()
 */
 DHTError MyDHT::readSafe()
 {
-    unsigned long now = millis();
-    uint16_t minInt = getMinReadInterval();
-
-    if (_lastReadMs != 0 && (now - _lastReadMs) < minInt)
+    if (!isReadAllowed())
     {
         // Too soon: do not read again
         return _lastError;
     }
 
-    _lastReadMs = now;
+    _lastReadMs = millis();
     return read();
 }
 
+/*
+  Minimum-interval guard shared by readSafe() and MultiDHTManager sweeps
+*/
+bool MyDHT::isReadAllowed() const
+{
+    return _lastReadMs == 0 || (millis() - _lastReadMs) >= getMinReadInterval();
+}
+
 /*
   Perform a single read attempt from the sensor
   @return DHTError code
 */
 DHTError MyDHT::readOnce()
 {
-    if constexpr (!mydht::optimizedBuild())
-    {
-        if (debugMode)
-            debugPrint("Starting single read attempt on pin %d", _pin);
-    }
-
-    // Send start signal
-    pinMode(_pin, OUTPUT);
-    digitalWrite(_pin, LOW);
-    delay(_timings.startLowMs); // Pull LOW for 20ms
-    digitalWrite(_pin, HIGH);
-    delayMicroseconds(30); // Then pull HIGH for 30µs
-    pinMode(_pin, INPUT_PULLUP);
-
-    // Wait for sensor ACK (empirical timeouts)
-    unsigned long timer = micros();
-    while (digitalRead(_pin) == HIGH)
-    {
-        if (micros() - timer > _timings.ackTimeoutUs) // Timeout
-        {
-            setError(DHT_ERROR_NO_RESPONSE);
-            return DHT_ERROR_NO_RESPONSE;
-        }
-    }
-
-    timer = micros();
-    while (digitalRead(_pin) == LOW)
-    {
-        if (micros() - timer > _timings.ackTimeoutUs)
-        {
-            setError(DHT_ERROR_TIMEOUT);
-            return DHT_ERROR_TIMEOUT;
-        }
-    }
+    trace(DHT_TRACE_ATTEMPT_START);
 
-    timer = micros();
-    while (digitalRead(_pin) == HIGH)
-    {
-        if (micros() - timer > _timings.ackTimeoutUs)
-        {
-            setError(DHT_ERROR_TIMEOUT);
-            return DHT_ERROR_TIMEOUT;
-        }
-    }
+    // Send start signal, then capture the sensor response right away
+    mydht::sendStartSignal(_pin, _timings.startLowMs);
 
     DHTError err = read5Bytes(); // Normal mode: read raw data from sensor
+    setError(err);
+    metricsAttempt(err);
 
-    if constexpr (!mydht::optimizedBuild())
-    {
-        if (debugMode)
-            debugPrint("readOnce result: %s", getErrorString(err));
-    }
-
+    trace(DHT_TRACE_ATTEMPT_RESULT, err);
     return err;
 
     // For DHT_TEST_MODE example usage:
@@ -244,78 +306,290 @@ DHTError MyDHT::readOnce()
 }
 
 /*
-  Reads 5 bytes of data from the DHT sensor
-  Internally calls readByte() for each byte and verifies the checksum
+  Reads the sensor response (ACK + 5 bytes) after the start signal.
+  Capture phase: mydht::captureFrame() records only the pulse durations while the sensor transmits.
+  Decode phase: the bytes and checksum are computed after the line has gone quiet.
   @return DHT_OK on success, otherwise one of the DHTError codes:
+        DHT_ERROR_NO_RESPONSE / DHT_ERROR_TIMEOUT if the ACK was not received
         DHT_ERROR_BIT_TIMEOUT if a bit read timed out
         DHT_ERROR_CHECKSUM if checksum validation fails
 */
 DHTError MyDHT::read5Bytes()
 {
-    int bitCounter = 0;
+    mydht::DHTPin io(_pin); // Cached port/mask lookup, outside the timed loop
+    unsigned long releaseUs = metricsClock();
+    DHTError err = mydht::captureFrame(io, _timings, _highTimes, _lowTimes);
+    if (err != DHT_OK)
+        return err;
+    metricsAck(releaseUs, metricsClock());
 
-    // Read 5 bytes
-    _byte1 = readByte(bitCounter);
-    if (_byte1 == 0xFF)
-    {
-        setError(DHT_ERROR_BIT_TIMEOUT);
-        return DHT_ERROR_BIT_TIMEOUT;
-    }
-    bitCounter += 8;
-    _byte2 = readByte(bitCounter);
-    if (_byte2 == 0xFF)
-    {
-        setError(DHT_ERROR_BIT_TIMEOUT);
-        return DHT_ERROR_BIT_TIMEOUT;
-    }
-    bitCounter += 8;
-    _byte3 = readByte(bitCounter);
-    if (_byte3 == 0xFF)
-    {
-        setError(DHT_ERROR_BIT_TIMEOUT);
-        return DHT_ERROR_BIT_TIMEOUT;
-    }
-    bitCounter += 8;
-    _byte4 = readByte(bitCounter);
-    if (_byte4 == 0xFF)
+    return decodeCapture();
+}
+
+/*
+  Decode phase of read5Bytes(), also used after a MultiDHTManager group capture.
+  @return DHT_OK or DHT_ERROR_CHECKSUM
+*/
+DHTError MyDHT::decodeCapture()
+{
+    // Decode 5 bytes
+    mydht::decodeFrame(_timings, _highTimes, _bytes);
+
+    trace(DHT_TRACE_RAW_BYTES, (_bytes[0] << 8) | _bytes[1], ((uint32_t)_bytes[2] << 16) | ((uint16_t)_bytes[3] << 8) | _bytes[4]);
+
+    // Verify checksum (adaptive timing may re-decode a failed frame)
+    if (checkFrame() != DHT_OK)
     {
-        setError(DHT_ERROR_BIT_TIMEOUT);
-        return DHT_ERROR_BIT_TIMEOUT;
+        trace(DHT_TRACE_CHECKSUM_MISMATCH, (uint8_t)(_bytes[0] + _bytes[1] + _bytes[2] + _bytes[3]), _bytes[4]);
+        return DHT_ERROR_CHECKSUM;
     }
-    bitCounter += 8;
-    _byte5 = readByte(bitCounter);
-    if (_byte5 == 0xFF)
+
+    trace(DHT_TRACE_DECODE_OK);
+    return DHT_OK;
+}
+
+namespace
+{
+    // Guard rails of the adaptive timing
+    const uint8_t LEARN_MIN_FRAMES = 4;     // Good frames before the threshold moves
+    const uint8_t MIN_SEPARATION_US = 16;   // 0- and 1-bit widths closer than this are not trusted
+    const uint16_t MAX_BIT_TIMEOUT_US = 250; // Pulse durations saturate at 255 µs
+
+    // Exponential average with weight 1/8, seeded by the first value
+    uint16_t emaQ4(uint16_t avg, uint16_t value)
     {
-        setError(DHT_ERROR_BIT_TIMEOUT);
-        return DHT_ERROR_BIT_TIMEOUT;
+        return avg == 0 ? value : avg + ((int16_t)(value - avg) >> 3);
     }
+}
 
-    if constexpr (!mydht::optimizedBuild())
+/*
+  Checksum of the decoded _bytes. In adaptive mode a failed frame gets one re-decode with
+  its own threshold, and every good frame feeds the timing statistics.
+*/
+DHTError MyDHT::checkFrame()
+{
+    bool ok = mydht::checksumOk(_bytes);
+    if (!_adaptiveTiming)
+        return ok ? DHT_OK : DHT_ERROR_CHECKSUM;
+
+    if (!ok && !rescueFrame())
+        return DHT_ERROR_CHECKSUM;
+
+    learnTiming();
+    return DHT_OK;
+}
+
+/*
+  Two-means split of the frame's 40 HIGH widths, starting between the shortest and longest.
+  The frame is kept only if the widths form two separated groups and the checksum then passes.
+*/
+bool MyDHT::rescueFrame()
+{
+    uint8_t shortest = 255, longest = 0;
+    for (uint8_t i = 0; i < 40; i++)
     {
-        if (debugMode)
-            debugPrint("Raw bytes: %X %X %X %X %X", _byte1, _byte2, _byte3, _byte4, _byte5);
+        if (_highTimes[i] < shortest)
+            shortest = _highTimes[i];
+        if (_highTimes[i] > longest)
+            longest = _highTimes[i];
     }
-    // Verify checksum
-    uint8_t sum = _byte1 + _byte2 + _byte3 + _byte4;
-    if (sum != _byte5)
+
+    uint8_t threshold = (shortest + longest) / 2;
+    for (uint8_t iter = 0; iter < 4; iter++)
     {
-        setError(DHT_ERROR_CHECKSUM);
-        if constexpr (!mydht::optimizedBuild())
+        uint16_t sum[2] = {0, 0};
+        uint8_t count[2] = {0, 0};
+        for (uint8_t i = 0; i < 40; i++)
         {
-            if (debugMode)
-                debugPrint("Checksum mismatch: %X != %X", sum, _byte5);
+            uint8_t bit = _highTimes[i] > threshold;
+            sum[bit] += _highTimes[i];
+            count[bit]++;
         }
-        return DHT_ERROR_CHECKSUM;
+        if (count[0] == 0 || count[1] == 0)
+            return false;
+
+        uint8_t zero = sum[0] / count[0];
+        uint8_t one = sum[1] / count[1];
+        if (one < zero + MIN_SEPARATION_US)
+            return false;
+
+        uint8_t next = (zero + one) / 2;
+        if (next == threshold)
+            break;
+        threshold = next;
     }
 
-    setError(DHT_OK);
-    _failureCount = 0;
-    if constexpr (!mydht::optimizedBuild())
+    DHTTimings t = _timings;
+    t.highThresholdUs = threshold;
+    uint8_t bytes[5];
+    mydht::decodeFrame(t, _highTimes, bytes);
+    if (!mydht::checksumOk(bytes))
+        return false;
+
+    memcpy(_bytes, bytes, sizeof(_bytes));
+    if (_rescuedFrames < 0xFFFF)
+        _rescuedFrames++;
+
+    trace(DHT_TRACE_CHECKSUM_RECOVERED, threshold);
+    return true;
+}
+
+/*
+  Updates the 0/1 HIGH width averages from a good frame and moves the threshold to their
+  midpoint and the bit timeout to twice the longest pulse, within the guard rails.
+*/
+void MyDHT::learnTiming()
+{
+    uint16_t sum[2] = {0, 0};
+    uint8_t count[2] = {0, 0};
+    uint8_t longest = 0;
+
+    for (uint8_t i = 0; i < 40; i++)
     {
-        if (debugMode)
-            debugPrint("read5Bytes: OK, checksum verified");
+        uint8_t bit = (_bytes[i >> 3] >> (7 - (i & 7))) & 1;
+        sum[bit] += _highTimes[i];
+        count[bit]++;
+        if (_highTimes[i] > longest)
+            longest = _highTimes[i];
+        if (_lowTimes[i] > longest)
+            longest = _lowTimes[i];
     }
-    return DHT_OK;
+
+    _longestQ4 = emaQ4(_longestQ4, (uint16_t)longest << 4);
+    uint16_t modelTimeout = (_type == DHT22) ? DHTModel<DHT22>::bitTimeoutUs : DHTModel<DHT11>::bitTimeoutUs;
+    uint16_t timeout = (_longestQ4 >> 4) * 2;
+    if (timeout < modelTimeout)
+        timeout = modelTimeout;
+    if (timeout > MAX_BIT_TIMEOUT_US)
+        timeout = MAX_BIT_TIMEOUT_US;
+    _timings.bitTimeoutUs = timeout;
+
+    if (count[0] == 0 || count[1] == 0)
+        return; // Only one bit value in this frame: no midpoint
+
+    _zeroHighQ4 = emaQ4(_zeroHighQ4, ((uint32_t)sum[0] << 4) / count[0]);
+    _oneHighQ4 = emaQ4(_oneHighQ4, ((uint32_t)sum[1] << 4) / count[1]);
+    if (_learnedFrames < 0xFFFF)
+        _learnedFrames++;
+
+    if (_learnedFrames < LEARN_MIN_FRAMES || _oneHighQ4 < _zeroHighQ4 + (MIN_SEPARATION_US << 4))
+        return;
+
+    uint16_t model = (_type == DHT22) ? DHTModel<DHT22>::highThresholdUs : DHTModel<DHT11>::highThresholdUs;
+    uint16_t threshold = (_zeroHighQ4 + _oneHighQ4) >> 5; // Midpoint, back to µs
+    if (threshold < model - model / 2)
+        threshold = model - model / 2;
+    if (threshold > model + model / 2)
+        threshold = model + model / 2;
+    _timings.highThresholdUs = threshold;
+}
+
+/*
+  Back to the model timings of the current type, learned statistics cleared
+*/
+void MyDHT::resetTiming()
+{
+    _timings = (_type == DHT22) ? DHTModel<DHT22>::timings() : DHTModel<DHT11>::timings();
+    _zeroHighQ4 = 0;
+    _oneHighQ4 = 0;
+    _longestQ4 = 0;
+    _learnedFrames = 0;
+    _rescuedFrames = 0;
+}
+
+/*
+  Enables adaptive bit timing; disabling it restores the model timings
+*/
+void MyDHT::setAdaptiveTiming(bool enable)
+{
+    _adaptiveTiming = enable;
+    _adaptiveTimingSet = true;
+    if (!enable)
+        resetTiming();
+}
+
+/*
+  Snapshot of what begin() would otherwise rediscover: type, retries, offsets, learned timing
+*/
+DHTProfile MyDHT::getProfile() const
+{
+    DHTProfile p;
+    p.pin = _pin;
+    p.type = _type;
+    p.adaptiveTiming = _adaptiveTiming;
+    p.retries = _retries;
+    p.tempOffsetC = _tempOffsetC10 / 10.0f;
+    p.humidityOffset = _humidityOffset10 / 10.0f;
+    p.highThresholdUs = _timings.highThresholdUs;
+    p.bitTimeoutUs = _timings.bitTimeoutUs;
+    p.zeroHighQ4 = _zeroHighQ4;
+    p.oneHighQ4 = _oneHighQ4;
+    return p;
+}
+
+/*
+  Restores a profile. Learned timing is kept within the adaptive guard rails, so a profile
+  cannot push the decoder outside what learnTiming() itself would allow. Adaptive timing set
+  with setAdaptiveTiming() before is kept.
+  @return false if the profile belongs to another pin or has no model
+*/
+bool MyDHT::applyProfile(const DHTProfile &profile)
+{
+    if (profile.pin != _pin || (profile.type != DHT11 && profile.type != DHT22))
+        return false;
+
+    setType(profile.type); // Model timings, learning reset
+    if (profile.retries > 0)
+        _retries = profile.retries;
+    setTemperatureOffset(profile.tempOffsetC);
+    setHumidityOffset(profile.humidityOffset);
+
+    if (!_adaptiveTimingSet)
+        _adaptiveTiming = profile.adaptiveTiming; // An explicit setAdaptiveTiming() call wins
+    if (_adaptiveTiming && profile.adaptiveTiming)
+    {
+        uint16_t model = _timings.highThresholdUs;
+        if (profile.highThresholdUs >= model - model / 2 && profile.highThresholdUs <= model + model / 2)
+            _timings.highThresholdUs = profile.highThresholdUs;
+        if (profile.bitTimeoutUs >= _timings.bitTimeoutUs && profile.bitTimeoutUs <= MAX_BIT_TIMEOUT_US)
+            _timings.bitTimeoutUs = profile.bitTimeoutUs;
+        _zeroHighQ4 = profile.zeroHighQ4; // Seeds for the running averages
+        _oneHighQ4 = profile.oneHighQ4;
+    }
+
+    _profileLoaded = true;
+    return true;
+}
+
+bool MyDHT::saveProfile(DHTProfileStorage &storage, uint16_t address) const
+{
+    if (_type == DHT_AUTO)
+        return false; // Nothing learned yet
+
+    uint8_t record[DHT_PROFILE_BYTES];
+    getProfile().encode(record);
+    return storage.write(address, record, sizeof(record));
+}
+
+bool MyDHT::loadProfile(DHTProfileStorage &storage, uint16_t address)
+{
+    uint8_t record[DHT_PROFILE_BYTES];
+    DHTProfile profile;
+    if (!storage.read(address, record, sizeof(record)) || !DHTProfile::decode(record, profile))
+        return false;
+    return applyProfile(profile);
+}
+
+DHTTimingStats MyDHT::getTimingStats() const
+{
+    DHTTimingStats stats;
+    stats.zeroHighUs = _zeroHighQ4 >> 4;
+    stats.oneHighUs = _oneHighQ4 >> 4;
+    stats.highThresholdUs = _timings.highThresholdUs;
+    stats.bitTimeoutUs = _timings.bitTimeoutUs;
+    stats.learnedFrames = _learnedFrames;
+    stats.rescuedFrames = _rescuedFrames;
+    return stats;
 }
 
 /*
@@ -324,18 +598,10 @@ DHTError MyDHT::read5Bytes()
 */
 float MyDHT::getHumidity()
 {
-    float hum;
-    if (_type == DHT11)
-    {
-        hum = _byte1 + _byte2 / 10.0;
-    }
-    else // DHT22
-    {
-        uint16_t raw = (_byte1 << 8) | _byte2;
-        hum = raw * 0.1;
-    }
+    float hum = (_type == DHT11) ? DHTModel<DHT11>::humidity(_bytes)
+                                 : DHTModel<DHT22>::humidity(_bytes); // DHT22
 
-    hum += _humidityOffset;
+    hum += _humidityOffset10 / 10.0f;
 
     // Clamp to 0–100%
     if (hum < 0.0)
@@ -352,39 +618,12 @@ float MyDHT::getHumidity()
 */
 float MyDHT::getTemperature(TempUnit unit)
 {
-    float tempC;
-
-    if (_type == DHT11)
-    {
-        tempC = _byte3 + _byte4 / 10.0;
-    }
-    else // DHT22
-    {
-        uint16_t raw = ((_byte3 & 0x7F) << 8) | _byte4;
-        tempC = raw * 0.1;
-
-        // Check for negative temperature
-        if (_byte3 & 0x80)
-        {
-            tempC = -tempC;
-        }
-    }
-
-    tempC += _tempOffsetC; // apply calibration offset
+    float tempC = (_type == DHT11) ? DHTModel<DHT11>::temperatureC(_bytes)
+                                   : DHTModel<DHT22>::temperatureC(_bytes); // DHT22
 
-    switch (unit)
-    {
-    case Celsius:
-        return tempC;
-    case Fahrenheit:
-        return tempC * 9.0 / 5.0 + 32;
-    case Kelvin:
-        return tempC + 273.15;
-    default:
-        return tempC;
-    }
+    tempC += _tempOffsetC10 / 10.0f; // apply calibration offset (stored in tenths)
 
-    return tempC;
+    return mydht::fromCelsius(tempC, unit);
 }
 
 /*
@@ -394,25 +633,13 @@ float MyDHT::getTemperature(TempUnit unit)
 */
 float MyDHT::getDewPoint(TempUnit unit)
 {
-    float T = getTemperature(Celsius);
-    float RH = getHumidity();
-    double a = 17.27;
-    double b = 237.7;
-    double alpha = ((a * T) / (b + T)) + log(RH / 100.0);
-    double dewPointC = (b * alpha) / (a - alpha);
-
-    // Convert to selected unit
-    switch (unit)
+    // Computed on first use, then memoized until the next sample
+    if (!(_derived & DERIVED_DEW_POINT))
     {
-    case Celsius:
-        return dewPointC;
-    case Fahrenheit:
-        return dewPointC * 9.0 / 5.0 + 32;
-    case Kelvin:
-        return dewPointC + 273.15;
-    default:
-        return dewPointC;
+        _dewPointC = mydht::dewPointC(getTemperature(Celsius), getHumidity());
+        _derived |= DERIVED_DEW_POINT;
     }
+    return mydht::fromCelsius(_dewPointC, unit);
 }
 
 /*
@@ -422,33 +649,100 @@ float MyDHT::getDewPoint(TempUnit unit)
 */
 float MyDHT::getHeatIndex(TempUnit unit)
 {
-    float T = getTemperature(Fahrenheit); // HI formula in F
-    float RH = getHumidity();
-
-    // Simple formula for HI < 80°F
-    float HI = 0.5 * (T + 61.0 + ((T - 68.0) * 1.2) + (RH * 0.094));
-
-    // Apply full Rothfusz regression if HI >= 80°F
-    if (HI >= 80.0)
+    // HI formula in F, memoized like the dew point
+    if (!(_derived & DERIVED_HEAT_INDEX))
     {
-        HI = -42.379 + 2.04901523 * T + 10.14333127 * RH - 0.22475541 * T * RH - 0.00683783 * T * T - 0.05481717 * RH * RH + 0.00122874 * T * T * RH + 0.00085282 * T * RH * RH - 0.00000199 * T * T * RH * RH;
+        _heatIndexF = mydht::heatIndexF(getTemperature(Fahrenheit), getHumidity());
+        _derived |= DERIVED_HEAT_INDEX;
     }
+    return mydht::fromFahrenheit(_heatIndexF, unit);
+}
 
-    // Convert to user-selected unit
-    switch (unit)
-    {
-    case Celsius:
-        return (HI - 32) * 5.0 / 9.0;
-    case Fahrenheit:
-        return HI;
-    case Kelvin:
-        return (HI - 32) * 5.0 / 9.0 + 273.15;
-    default:
-        return (HI - 32) * 5.0 / 9.0;
+/*
+  Get last read temperature in tenths of the requested unit (integer only)
+  @return e.g. 235 for 23.5 °C
+*/
+int16_t MyDHT::getTemperatureDeci(TempUnit unit)
+{
+    int16_t tempC10 = (_type == DHT11) ? DHTModel<DHT11>::temperatureTenths(_bytes)
+                                       : DHTModel<DHT22>::temperatureTenths(_bytes); // DHT22
+
+    return mydht::fromCelsiusDeci(tempC10 + _tempOffsetC10, unit);
+}
+
+/*
+  Get last read humidity in tenths of %RH (integer only), clamped to 0–1000
+*/
+uint16_t MyDHT::getHumidityDeci()
+{
+    int32_t hum10 = (_type == DHT11) ? DHTModel<DHT11>::humidityTenths(_bytes)
+                                     : DHTModel<DHT22>::humidityTenths(_bytes); // DHT22
+
+    hum10 += _humidityOffset10;
+
+    // Clamp to 0–100%
+    if (hum10 < 0)
+        hum10 = 0;
+    if (hum10 > 1000)
+        hum10 = 1000;
+
+    return hum10;
+}
+
+/*
+  Dew point in tenths of the requested unit (fixed-point Magnus formula)
+  @return DHT_FIXED_INVALID for 0 %RH
+*/
+int16_t MyDHT::getDewPointDeci(TempUnit unit)
+{
+    int16_t dewC10 = mydht::dewPointDeciC(getTemperatureDeci(Celsius), getHumidityDeci());
+    return dewC10 == DHT_FIXED_INVALID ? DHT_FIXED_INVALID : mydht::fromCelsiusDeci(dewC10, unit);
+}
+
+/*
+  Heat index in tenths of the requested unit (integer Rothfusz regression)
+*/
+int16_t MyDHT::getHeatIndexDeci(TempUnit unit)
+{
+    return mydht::fromFahrenheitDeci(mydht::heatIndexDeciF(getTemperatureDeci(Celsius), getHumidityDeci()), unit);
+}
+
+/*
+  Reads the sensor and returns the fixed-point data package.
+  Unlike getData() there is no last-valid fallback: on error every value is DHT_FIXED_INVALID(_HUM).
+*/
+DHTFixedData MyDHT::getFixedData(TempUnit unit, bool derived)
+{
+    DHTError err = read();
+    if (err != DHT_OK)
+    {
+        DHTFixedData data;
+        data.temp = DHT_FIXED_INVALID;
+        data.hum = DHT_FIXED_INVALID_HUM;
+        data.dew = DHT_FIXED_INVALID;
+        data.hi = DHT_FIXED_INVALID;
+        data.status = err;
+        return data;
     }
+    return makeFixedData(unit, derived);
+}
+
+/*
+  Packages the last read raw bytes into a DHTFixedData structure (integer math only)
+  @param derived false skips dew point and heat index (left DHT_FIXED_INVALID)
+*/
+DHTFixedData MyDHT::makeFixedData(TempUnit unit, bool derived)
+{
+    DHTFixedData d;
+    d.temp = getTemperatureDeci(unit);
+    d.hum = getHumidityDeci();
+    d.dew = derived ? getDewPointDeci(unit) : DHT_FIXED_INVALID;
+    d.hi = derived ? getHeatIndexDeci(unit) : DHT_FIXED_INVALID;
+    d.status = DHT_OK;
+    return d;
 }
 
-DHTData MyDHT::getData(TempUnit unit)
+DHTData MyDHT::getData(TempUnit unit, bool derived)
 {
     if constexpr (mydht::optimizedBuild())
     {
@@ -463,7 +757,7 @@ DHTData MyDHT::getData(TempUnit unit)
         }
         else
         {
-            data = makeData(unit);
+            data = makeData(unit, derived);
         }
         return data;
     }
@@ -492,8 +786,8 @@ DHTData MyDHT::getData(TempUnit unit)
 
         data.temp = getTemperature(unit);
         data.hum = getHumidity();
-        data.dew = getDewPoint(unit);
-        data.hi = getHeatIndex(unit);
+        data.dew = derived ? getDewPoint(unit) : NAN;
+        data.hi = derived ? getHeatIndex(unit) : NAN;
 
         _lastValidData = data;
         _hasLastValidData = true;
@@ -503,108 +797,63 @@ DHTData MyDHT::getData(TempUnit unit)
 }
 
 /*
-  Set temperature calibration offset
+  Set temperature calibration offset, rounded to the nearest tenth of °C
 */
 void MyDHT::setTemperatureOffset(float offsetC)
 {
-    _tempOffsetC = offsetC;
+    setTemperatureOffsetDeci((int16_t)(offsetC * 10 + (offsetC < 0 ? -0.5f : 0.5f)));
 }
 
 /*
-  Set humidity calibration offset
+  Set humidity calibration offset, rounded to the nearest tenth of %RH
 */
 void MyDHT::setHumidityOffset(float offset)
 {
-    _humidityOffset = offset;
+    setHumidityOffsetDeci((int16_t)(offset * 10 + (offset < 0 ? -0.5f : 0.5f)));
 }
 
 /*
- Set number of retry attempts for read()
+  Set temperature calibration offset in tenths of °C (fixed-point API)
 */
-void MyDHT::setRetries(uint8_t retries)
+void MyDHT::setTemperatureOffsetDeci(int16_t offsetC10)
 {
-    _retries = retries;
+    _tempOffsetC10 = offsetC10;
+    _derived = 0; // Derived values include the offsets
 }
 
 /*
-  Read a single bit from the sensor
-  @return 0, 1, or -1 on timeout/error
+  Set humidity calibration offset in tenths of %RH (fixed-point API)
 */
-int MyDHT::readOneBit(int counter)
+void MyDHT::setHumidityOffsetDeci(int16_t offset10)
 {
-    unsigned long t = micros();
-    // Wait for LOW signal
-    while (digitalRead(_pin) == HIGH)
-    {
-        if (micros() - t > _timings.bitTimeoutUs) // 120µs timeout
-            return -1;
-    }
-
-    t = micros();
-    // Measure LOW duration
-    while (digitalRead(_pin) == LOW)
-    {
-        if (micros() - t > _timings.bitTimeoutUs) // 120µs timeout
-            return -1;
-    }
-    unsigned long lowDuration = micros() - t;
-    _lowTimes[counter] = lowDuration;
-
-    unsigned long highStart = micros();
-    // Start HIGH timer
-    while (digitalRead(_pin) == HIGH)
-    {
-        if (micros() - highStart > _timings.bitTimeoutUs) // 120µs timeout
-            return -1;
-    }
-
-    unsigned long highDuration = micros() - highStart;
-    _highTimes[counter] = highDuration;
-    // Determine bit value based on HIGH pulse duration
-    if (highDuration > _timings.highThresholdUs)
-        return 1;
-    else
-        return 0;
+    _humidityOffset10 = offset10;
+    _derived = 0;
 }
 
 /*
-  Read a byte (8 bits) from the sensor
-  @return Byte value or 0xFF on error
+ Set number of retry attempts for read()
 */
-uint8_t MyDHT::readByte(int counter)
+void MyDHT::setRetries(uint8_t retries)
 {
-    uint8_t result = 0;
-
-    for (int i = 0; i < 8; i++)
-    {
-        int bit = readOneBit(counter + i);
-
-        if (bit < 0)
-            return 0xFF;
-
-        result <<= 1;
-        result |= bit;
-    }
-
-    return result;
+    _retries = retries;
 }
 
 /*
   Get raw sensor bytes from the last read
   @return DHTRawData struct containing:
-    - lowTimes[40]  : Duration of LOW pulses in microseconds
-    - highTimes[40] : Duration of HIGH pulses in microseconds
+    - lowTimes[40]  : Duration of LOW pulses in microseconds (saturated at 255)
+    - highTimes[40] : Duration of HIGH pulses in microseconds (saturated at 255)
     - bytes[5]      : Last 5 bytes read from sensor
 */
 DHTRawData MyDHT::getRawData()
 {
     DHTRawData data;
     // Store last 5 bytes read from sensor
-    data.bytes[0] = _byte1;
-    data.bytes[1] = _byte2;
-    data.bytes[2] = _byte3;
-    data.bytes[3] = _byte4;
-    data.bytes[4] = _byte5;
+    data.bytes[0] = _bytes[0];
+    data.bytes[1] = _bytes[1];
+    data.bytes[2] = _bytes[2];
+    data.bytes[3] = _bytes[3];
+    data.bytes[4] = _bytes[4];
 
     for (int i = 0; i < 40; i++)
     {
@@ -615,6 +864,56 @@ DHTRawData MyDHT::getRawData()
     return data;
 }
 
+/*
+  Get a read-only view of the last capture without copying it
+  @return DHTRawView pointing into this sensor's buffers (valid until the next read)
+*/
+DHTRawView MyDHT::getRawView() const
+{
+    DHTRawView view;
+    view.bytes = _bytes;
+    view.highTimes = _highTimes;
+    view.lowTimes = _lowTimes;
+    return view;
+}
+
+/*
+  Interrupt trampolines for the edge-driven async engine.
+  attachInterrupt() takes a plain function pointer, so each slot forwards to the MyDHT that claimed it.
+*/
+static_assert(DHT_ASYNC_ISR_SLOTS >= 1 && DHT_ASYNC_ISR_SLOTS <= 4, "DHT_ASYNC_ISR_SLOTS must be 1-4");
+
+namespace
+{
+    MyDHT *volatile isrOwners[DHT_ASYNC_ISR_SLOTS];
+
+    void DHT_ISR_ATTR dhtEdgeIsr0()
+    {
+        if (isrOwners[0])
+            isrOwners[0]->onPinEdge(micros());
+    }
+
+    void DHT_ISR_ATTR dhtEdgeIsr1()
+    {
+        if (isrOwners[1])
+            isrOwners[1]->onPinEdge(micros());
+    }
+
+    void DHT_ISR_ATTR dhtEdgeIsr2()
+    {
+        if (isrOwners[2])
+            isrOwners[2]->onPinEdge(micros());
+    }
+
+    void DHT_ISR_ATTR dhtEdgeIsr3()
+    {
+        if (isrOwners[3])
+            isrOwners[3]->onPinEdge(micros());
+    }
+
+    void (*const isrTable[4])() = {dhtEdgeIsr0, dhtEdgeIsr1, dhtEdgeIsr2, dhtEdgeIsr3};
+}
+
 /*
   Starts an asynchronous read from the DHT sensor.
   @param cb User-provided callback function to be called when the read is complete.
@@ -622,98 +921,340 @@ DHTRawData MyDHT::getRawData()
 */
 void MyDHT::startAsyncRead(DHTCallback cb)
 {
-    _callback = cb;          // Store the user-defined callback function
+    detachEdgeCapture();    // Release the interrupt of an unfinished previous read
+    _starting = false;      // Replaces an unfinished beginAsync()
+    _callback = cb;         // Store the user-defined callback function
+    _contextCallback = nullptr;
+    _asyncAttempt = 0;      // Failed attempts are retried per the retry policy
+    _lastReadMs = millis(); // Async reads count for the readSafe() interval too
+    beginAttempt();
+}
+
+/*
+  Same as startAsyncRead(DHTCallback), but the callback also gets the sensor and context,
+  so one function can handle many sensors (context: an index, a struct of the caller...).
+*/
+void MyDHT::startAsyncRead(DHTContextCallback cb, void *context)
+{
+    startAsyncRead(static_cast<DHTCallback>(nullptr));
+    _contextCallback = cb;
+    _context = context;
+}
+
+/*
+  Queues a read that never blocks: it starts when getMinReadInterval() allows it (like readSafe()),
+  and processAsync() reschedules failed attempts instead of waiting between them.
+*/
+bool MyDHT::requestRead(DHTCallback cb)
+{
+    if (_state != IDLE)
+        return false;
+
+    _callback = cb;
+    _contextCallback = nullptr;
+    _asyncAttempt = 0;
+
+    if (isReadAllowed())
+    {
+        _lastReadMs = millis();
+        beginAttempt();
+    }
+    else
+    {
+        _scheduledMs = _lastReadMs + getMinReadInterval();
+        _state = SCHEDULED;
+    }
+    return true;
+}
+
+bool MyDHT::requestRead(DHTContextCallback cb, void *context)
+{
+    if (!requestRead(static_cast<DHTCallback>(nullptr)))
+        return false;
+
+    _contextCallback = cb;
+    _context = context;
+    return true;
+}
+
+/*
+  Starts one attempt of an async read with the start signal
+*/
+void MyDHT::beginAttempt()
+{
+#if DHT_METRICS
+    if (_asyncAttempt == 0)
+        _asyncStartUs = micros();
+#endif
     _state = START_SIGNAL;   // Set the state to START_SIGNAL to begin the start sequence
     pinMode(_pin, OUTPUT);   // Set the pin as OUTPUT to send the start signal
     digitalWrite(_pin, LOW); // Pull the pin LOW to signal the sensor to start sending data
     _timer = millis();       // Record the current time to measure start signal duration
 }
 
+/*
+  Delay before the next async attempt: firstDelayMs after the first failure,
+  multiplied by backoff after every further one, capped at maxDelayMs
+*/
+uint16_t MyDHT::retryDelayMs() const
+{
+    uint32_t delayMs = _retryPolicy.firstDelayMs;
+    if (delayMs == 0)
+        delayMs = (_type == DHT11) ? DHTModel<DHT11>::retryDelayMs : DHTModel<DHT22>::retryDelayMs;
+
+    for (uint8_t k = 1; k < _asyncAttempt && delayMs < _retryPolicy.maxDelayMs; k++)
+        delayMs *= _retryPolicy.backoff;
+
+    return (delayMs > _retryPolicy.maxDelayMs) ? _retryPolicy.maxDelayMs : delayMs;
+}
+
 /*
   Processes the asynchronous state machine.
   Should be called repeatedly (e.g., inside loop()) until isReading() returns false.
   Handles:
-    - START_SIGNAL: Sends start signal to sensor
-    - WAIT_ACK: Waits for sensor acknowledgment
-    - READ_BITS_BLOCKING: Reads 5 bytes from sensor and calls the callback
+    - SCHEDULED: Starts the next attempt once its deadline has passed
+    - START_SIGNAL: Sends start signal to sensor and starts recording line edges
+    - WAIT_ACK: Waits for the sensor acknowledgment edges
+    - READ_BITS: Decodes the bits recorded so far by the pin interrupt, never waits on the line
+    - READ_BITS_BLOCKING: Fallback for pins without an interrupt, reads the response in one go
+      (every attempt of an optimized build)
     - ERROR_STATE: Handles errors and calls the callback with error status
 */
 void MyDHT::processAsync()
 {
-    if constexpr (mydht::optimizedBuild())
+    unsigned long callUs = metricsClock();
+    switch (_state)
     {
-        // Memory-light build: read5Bytes and return
-        if (_state == READ_BITS_BLOCKING)
-        {
-            read5Bytes();
-            _state = IDLE;
-        }
-        else if (_state != IDLE)
+    case SCHEDULED:
+    {
+        // Signed difference: the deadline may lie across the millis() rollover
+        if ((long)(millis() - _scheduledMs) >= 0)
         {
-            _state = IDLE;
+            if (_asyncAttempt == 0)
+                _lastReadMs = millis(); // requestRead() waited for the read interval
+            beginAttempt();
         }
-        return;
+        break;
     }
-    switch (_state)
-    {
+
     case START_SIGNAL:
     {
-        // Wait for the start signal (LOW) to last at least 20ms
-        if (millis() - _timer >= _timings.startLowMs)
+        // Wait for the start signal (LOW) to last at least startLowMs; with millis() ticks of
+        // 1 ms, ">=" could release the line up to 1 ms early (too short for a DHT11)
+        if (millis() - _timer > _timings.startLowMs)
         {
             digitalWrite(_pin, HIGH); // Pull the pin HIGH to finish the start signal
             delayMicroseconds(30);
             pinMode(_pin, INPUT_PULLUP); // Switch pin to INPUT_PULLUP to read sensor response
             _timer = micros();           // Record the start time for waiting ACK signal
-            _state = WAIT_ACK;           // Change state to WAIT_ACK
+
+            // Record edges from the pin interrupt; the memory-light build has no edge capture
+            if (!mydht::optimizedBuild() && attachEdgeCapture())
+            {
+                _state = WAIT_ACK; // Change state to WAIT_ACK
+            }
+            else
+            {
+                // No interrupt on this pin: the response must be captured right away (~5ms blocking)
+                _state = READ_BITS_BLOCKING;
+                finishAsync(read5Bytes());
+            }
         }
         break;
     }
 
     case WAIT_ACK:
     {
-        if (micros() - _timer >= _timings.ackDoneUs)
+        // The ACK is complete once the sensor starts the first bit
+        if (_edgeCount >= 3)
         {
-            // Wait for the sensor to pull the line LOW (after ACK)
-            if (digitalRead(_pin) == LOW)
-            {
-                _state = READ_BITS_BLOCKING; // ACK received, move to reading bits
-            }
-            // Timeout: sensor did not respond
-            else if (micros() - _timer > _timings.ackTimeoutUs)
-            {
-                _state = ERROR_STATE;
-            }
+            _asyncBit = 0;
+            _state = READ_BITS;
+        }
+        // Timeout: sensor did not respond
+        else if (micros() - _timer > _timings.ackTimeoutUs)
+        {
+            _asyncError = (_edgeCount == 0) ? DHT_ERROR_NO_RESPONSE : DHT_ERROR_TIMEOUT;
+            _state = ERROR_STATE;
         }
         break;
     }
 
-    case READ_BITS_BLOCKING:
+    case READ_BITS:
     {
-        DHTError e = read5Bytes(); // Read all 5 bytes from the sensor
-        DHTData data = makeData();
-        data.status = e;
-        if (_callback)
-            _callback(data); // Call user-defined callback with the data
-        _state = IDLE;
+        // Snapshot the ISR-owned counters atomically (unsigned long is not atomic on AVR)
+        noInterrupts();
+        uint8_t edges = _edgeCount;
+        unsigned long lastEdgeUs = _edgeLastUs;
+        interrupts();
+
+        // A bit is complete once its falling edge (end of HIGH pulse) has been recorded
+        uint8_t completeBits = (edges - 3) / 2;
+        while (_asyncBit < completeBits)
+        {
+            uint8_t &b = _bytes[_asyncBit >> 3];
+            b = (b << 1) | (_highTimes[_asyncBit] > _timings.highThresholdUs ? 1 : 0);
+            _asyncBit++;
+        }
+
+        if (_asyncBit >= 40)
+        {
+            metricsAck(_timer, lastEdgeUs);
+            finishAsync(checkFrame());
+        }
+        else
+        {
+            // Edges may have arrived during the decode loop: time the gap from the latest one,
+            // taking the clock in the same critical section so the edge cannot lie after it
+            noInterrupts();
+            unsigned long sinceEdgeUs = micros() - _edgeLastUs;
+            interrupts();
+
+            if (sinceEdgeUs > _timings.bitTimeoutUs)
+                finishAsync(DHT_ERROR_BIT_TIMEOUT);
+        }
         break;
     }
 
     case ERROR_STATE:
     {
         // Handle errors such as no response
-        DHTData d;
-        setError(DHT_ERROR_NO_RESPONSE);
-        d.status = DHT_ERROR_NO_RESPONSE;
-        if (_callback)
-            _callback(d); // Notify user via callback
-        _state = IDLE;    // Reset state
+        finishAsync(_asyncError);
         break;
     }
 
     default:
         break;
     }
+    metricsBlocking(callUs);
+}
+
+/*
+  Records one line edge for the edge-driven async engine.
+  Edge 0 is the sensor pulling the line LOW, edges 1-2 end the ACK LOW/HIGH phases.
+  From edge 3 on, odd offsets end a bit's LOW phase and even offsets end its HIGH phase.
+  Only stores durations; decoding happens in processAsync().
+*/
+void DHT_ISR_ATTR MyDHT::onPinEdge(unsigned long timestampUs)
+{
+    uint8_t idx = _edgeCount;
+    if (_isrSlot < 0 || idx >= DHT_FRAME_EDGES)
+        return; // Not capturing, or trailing release edge after the frame
+
+    unsigned long duration = timestampUs - _edgeLastUs;
+    _edgeLastUs = timestampUs;
+
+    if (idx >= 3)
+    {
+        uint8_t k = idx - 3;
+        if (k & 1)
+            _highTimes[k >> 1] = duration > 255 ? 255 : duration;
+        else
+            _lowTimes[k >> 1] = duration > 255 ? 255 : duration;
+    }
+
+    _edgeCount = idx + 1;
+}
+
+/*
+  Claims a free interrupt trampoline and attaches it to the sensor pin.
+  @return false if the pin has no external interrupt or all slots are taken
+*/
+bool MyDHT::attachEdgeCapture()
+{
+    int irq = digitalPinToInterrupt(_pin);
+    if (irq == NOT_AN_INTERRUPT)
+        return false;
+
+    for (uint8_t i = 0; i < DHT_ASYNC_ISR_SLOTS; i++)
+    {
+        if (isrOwners[i] == nullptr)
+        {
+            _isrSlot = i;
+            _edgeCount = 0;
+            _edgeLastUs = micros();
+            for (uint8_t j = 0; j < 5; j++)
+                _bytes[j] = 0;
+
+            isrOwners[i] = this;
+            attachInterrupt(irq, isrTable[i], CHANGE);
+
+            // The sensor may already have pulled the line LOW before the interrupt was armed
+            noInterrupts();
+            if (_edgeCount == 0 && digitalRead(_pin) == LOW)
+                onPinEdge(micros());
+            interrupts();
+            return true;
+        }
+    }
+    return false;
+}
+
+/*
+  Detaches the pin interrupt and frees the trampoline slot.
+*/
+void MyDHT::detachEdgeCapture()
+{
+    if (_isrSlot < 0)
+        return;
+
+    detachInterrupt(digitalPinToInterrupt(_pin));
+    isrOwners[_isrSlot] = nullptr;
+    _isrSlot = -1;
+}
+
+/*
+  Ends an async attempt: releases the interrupt, then either schedules a retry or records the
+  error and calls the callback. On failure the values are NaN, like getData() without a fallback.
+*/
+void MyDHT::finishAsync(DHTError err)
+{
+    detachEdgeCapture();
+    metricsAttempt(err);
+
+    // DHT_AUTO: the first good frame decides the model; a frame neither model can produce is retried
+    if (err == DHT_OK && _type == DHT_AUTO && !detectFromFrame())
+        err = DHT_ERROR_SANITY;
+
+    // Like read(), retry failed attempts; the wait is a deadline checked by processAsync()
+    if (err != DHT_OK && _asyncAttempt + 1 < _retries)
+    {
+        _asyncAttempt++;
+        uint16_t waitMs = retryDelayMs();
+        _scheduledMs = millis() + waitMs;
+        _state = SCHEDULED;
+
+        trace(DHT_TRACE_ASYNC_RETRY, _asyncAttempt | (err << 8), waitMs);
+        return;
+    }
+
+    setError(err);
+#if DHT_METRICS
+    metricsRead(_asyncStartUs, _asyncAttempt + 1, err, false);
+#endif
+    publish(err);
+
+    DHTData d;
+    if (err == DHT_OK)
+    {
+        recordSample();
+        d = makeData();
+    }
+    else
+    {
+        d.temp = NAN;
+        d.hum = NAN;
+        d.dew = NAN;
+        d.hi = NAN;
+    }
+    d.status = err;
+
+    _starting = false;
+    _state = IDLE; // Reset state before the callback so it may start the next read
+    if (_callback)
+        _callback(d);
+    else if (_contextCallback)
+        _contextCallback(*this, d, _context);
 }
 
 /*
@@ -727,51 +1268,48 @@ bool MyDHT::isReading()
 
 /*
   Packages the last read raw bytes into a DHTData structure.
-  Calculates temperature, humidity, dew point, and heat index.
+  Calculates temperature, humidity and, if derived is true, dew point and heat index.
+  @param derived false skips dew point and heat index (left NaN)
   @return DHTData structure with all calculated values and status set to DHT_OK
 */
-DHTData MyDHT::makeData(TempUnit unit)
+DHTData MyDHT::makeData(TempUnit unit, bool derived)
 {
     DHTData d;
     d.temp = getTemperature(unit);
     d.hum = getHumidity();
-    d.dew = getDewPoint(unit);
-    d.hi = getHeatIndex(unit);
+    d.dew = derived ? getDewPoint(unit) : NAN;
+    d.hi = derived ? getHeatIndex(unit) : NAN;
     d.status = DHT_OK;
     return d;
 }
 
 /*
-  Attempts to automatically detect the sensor type (DHT11 or DHT22).
-  Performs a single read to get raw bytes and applies a heuristic:
-  - DHT11 typically has byte2 and byte4 equal to 0 and small temperature/humidity values.
-  - DHT22 has non-zero decimal bytes or larger values.
-  If the read fails, type remains DHT_AUTO for later retry.
+  Attempts to automatically detect the sensor type (DHT11 or DHT22) with a single read.
+  The DHT_AUTO timings (18 ms start signal) wake up both models and their bit timing is the same,
+  so one capture works for either; mydht::detectModel() then tells the models apart by the
+  frame layout.
+  If the read fails, type remains DHT_AUTO and the first successful read() detects it.
 */
 void MyDHT::detectType()
 {
-    // 1) Try reading as DHT22
-    _type = DHT22;
-    _timings = {2, 3000, 80, 200, 40};
-    if (readOnce() == DHT_OK && sanityCheck())
-    {
-        // Valid DHT22 frame → finished
-        return;
-    }
-
-    delay(1500);
+    _type = DHT_AUTO;
+    resetTiming();
+    if (readOnce() == DHT_OK)
+        detectFromFrame();
+}
 
-    // 2) Try reading as DHT11
-    _type = DHT11;
-    _timings = {18, 5000, 80, 200, 50};
-    if (readOnce() == DHT_OK && sanityCheck())
-    {
-        // Valid DHT11 frame → finished
-        return;
-    }
+/*
+  Sets the type from the layout of the frame in _bytes (checksum already verified).
+  @return false if neither model can produce this frame; the type stays DHT_AUTO
+*/
+bool MyDHT::detectFromFrame()
+{
+    DHTType type = mydht::detectModel(_bytes);
+    if (type == DHT_AUTO)
+        return false;
 
-    // If neither worked
-    _type = DHT_AUTO;
+    setType(type);
+    return true;
 }
 
 /*
@@ -785,19 +1323,8 @@ DHTType MyDHT::getType() { return _type; }
 void MyDHT::setType(DHTType type)
 {
     _type = type;
-
-    switch (_type)
-    {
-    case DHT11:
-        _timings = {18, 5000, 80, 200, 50};
-        break;
-    case DHT22:
-        _timings = {2, 3000, 80, 200, 40};
-        break;
-    default:
-        _timings = {18, 5000, 80, 200, 50};
-        break;
-    }
+    _derived = 0; // Same bytes, different decoding
+    resetTiming();
 }
 
 /*
@@ -805,13 +1332,11 @@ void MyDHT::setType(DHTType type)
   DHT11: ~1s minimum (datasheet), DHT22: ~2s minimum (datasheet).
   AUTO: return 2000ms as a safe default.
 */
-uint16_t MyDHT::getMinReadInterval()
+uint16_t MyDHT::getMinReadInterval() const
 {
-    if (_type == DHT22)
-        return 2000;
     if (_type == DHT11)
-        return 1200; // Note: DHT11 datasheet allows ~1s, but 1.2s is often more reliable on real wiring/modules.
-    return 2000;     // DHT_AUTO -> safe default
+        return DHTModel<DHT11>::minReadIntervalMs;
+    return DHTModel<DHT22>::minReadIntervalMs; // DHT22, DHT_AUTO -> safe default
 }
 
 /*
@@ -835,6 +1360,11 @@ bool MyDHT::isConnected() const { return _failureCount < 5; }
   @return const char* describing the error
 */
 const char *MyDHT::getErrorString(DHTError err)
+{
+    return mydht::errorString(err);
+}
+
+const char *mydht::errorString(DHTError err)
 {
     switch (err)
     {
@@ -860,49 +1390,25 @@ const char *MyDHT::getErrorString(DHTError err)
 /*
   Performs validation of the decoded temperature and humidity values.
   Ensures that all readings fall within the allowed range for the sensor model.
+  Works on the integer fields of the frame (tenths), so no float math runs per attempt.
   @return true if data is valid, false if values are unrealistic or out-of-range.
 */
 bool MyDHT::sanityCheck()
 {
-    // DHTData object from the current raw bytes
-    DHTData d = makeData(Celsius);
+    bool ok = (_type == DHT11) ? mydht::plausible<DHT11>(_bytes)
+                               : mydht::plausible<DHT22>(_bytes); // DHT22, DHT_AUTO
 
     if constexpr (!mydht::optimizedBuild())
     {
         if (debugMode)
-            debugPrint("Sanity check: Temp=%f, Hum=%f", d.temp, d.hum);
-    }
-
-    float temp = d.temp;
-    float hum = d.hum;
-
-    // Apply model-specific temperature bounds
-    float minTemp = (_type == DHT11) ? DHT11_MIN_TEMP : DHT22_MIN_TEMP;
-    float maxTemp = (_type == DHT11) ? DHT11_MAX_TEMP : DHT22_MAX_TEMP;
-
-    // Reject invalid or out-of-range temperatures
-    if (isnan(temp) || temp < minTemp || temp > maxTemp)
-    {
-        if constexpr (!mydht::optimizedBuild())
-        {
-            if (debugMode)
-                debugPrint("Sanity check failed: Temperature=%f out of range", d.temp);
-        }
-        return false;
-    }
-
-    // Reject invalid humidity (must be 0–100%)
-    if (isnan(hum) || hum < 0.0f || hum > 100.0f)
-    {
-        if constexpr (!mydht::optimizedBuild())
         {
-            if (debugMode)
-                debugPrint("Sanity check failed: Humidity=%f out of range", d.hum);
+            int16_t temp = (_type == DHT11) ? DHTModel<DHT11>::temperatureTenths(_bytes) : DHTModel<DHT22>::temperatureTenths(_bytes);
+            uint16_t hum = (_type == DHT11) ? DHTModel<DHT11>::humidityTenths(_bytes) : DHTModel<DHT22>::humidityTenths(_bytes);
+            trace(DHT_TRACE_SANITY, ok, ((uint32_t)(uint16_t)temp << 16) | hum);
         }
-        return false;
     }
 
-    return true;
+    return ok;
 }
 
 /*
@@ -921,92 +1427,359 @@ void MyDHT::setRawBytes(uint8_t b1, uint8_t b2, uint8_t b3, uint8_t b4, uint8_t
         if (!testMode)
             return;
 
-        _byte1 = b1;
-        _byte2 = b2;
-        _byte3 = b3;
-        _byte4 = b4;
-        _byte5 = b5;
+        _bytes[0] = b1;
+        _bytes[1] = b2;
+        _bytes[2] = b3;
+        _bytes[3] = b4;
+        _bytes[4] = b5;
+        _derived = 0; // New sample
     }
 }
 
 /*
-  Prints formatted debug messages to Serial with a "[DHT DEBUG]" prefix.
-  Used for internal library debugging.
+  Converts a temperature in °C to the requested unit.
+*/
+float mydht::fromCelsius(double tempC, TempUnit unit)
+{
+    switch (unit)
+    {
+    case Fahrenheit:
+        return tempC * 9.0 / 5.0 + 32;
+    case Kelvin:
+        return tempC + 273.15;
+    case Celsius:
+    default:
+        return tempC;
+    }
+}
 
-  Supports:
-    - %f for floats
-    - %d for integers
-    - %s for C-strings
-    - %X for hexadecimal integers
+/*
+  Converts a temperature in °F to the requested unit.
 */
-void MyDHT::debugPrint(const char *fmt, ...)
+float mydht::fromFahrenheit(float tempF, TempUnit unit)
 {
-    if constexpr (mydht::optimizedBuild())
+    switch (unit)
     {
-        // In optimized build debug mode is disabled
-        return;
+    case Fahrenheit:
+        return tempF;
+    case Kelvin:
+        return (tempF - 32) * 5.0 / 9.0 + 273.15;
+    case Celsius:
+    default:
+        return (tempF - 32) * 5.0 / 9.0;
     }
-    else
+}
+
+#if DHT_FAST_MATH
+namespace
+{
+    // ln(RH / 100) for integer RH 1-100: DHT11 readings (and most DHT22 ones) hit this table directly
+    const float lnRelHumidityTable[100] PROGMEM = {
+        -4.6051702f, -3.9120230f, -3.5065579f, -3.2188758f, -2.9957323f, -2.8134107f, -2.6592600f, -2.5257286f,
+        -2.4079456f, -2.3025851f, -2.2072749f, -2.1202635f, -2.0402208f, -1.9661129f, -1.8971200f, -1.8325815f,
+        -1.7719568f, -1.7147984f, -1.6607312f, -1.6094379f, -1.5606477f, -1.5141277f, -1.4696760f, -1.4271164f,
+        -1.3862944f, -1.3470736f, -1.3093333f, -1.2729657f, -1.2378744f, -1.2039728f, -1.1711830f, -1.1394343f,
+        -1.1086626f, -1.0788097f, -1.0498221f, -1.0216512f, -0.9942523f, -0.9675840f, -0.9416085f, -0.9162907f,
+        -0.8915981f, -0.8675006f, -0.8439701f, -0.8209806f, -0.7985077f, -0.7765288f, -0.7550226f, -0.7339692f,
+        -0.7133499f, -0.6931472f, -0.6733446f, -0.6539265f, -0.6348783f, -0.6161861f, -0.5978370f, -0.5798185f,
+        -0.5621189f, -0.5447272f, -0.5276327f, -0.5108256f, -0.4942963f, -0.4780358f, -0.4620355f, -0.4462871f,
+        -0.4307829f, -0.4155154f, -0.4004776f, -0.3856625f, -0.3710637f, -0.3566749f, -0.3424903f, -0.3285041f,
+        -0.3147107f, -0.3011051f, -0.2876821f, -0.2744368f, -0.2613648f, -0.2484614f, -0.2357223f, -0.2231436f,
+        -0.2107210f, -0.1984509f, -0.1863296f, -0.1743534f, -0.1625189f, -0.1508229f, -0.1392621f, -0.1278334f,
+        -0.1165338f, -0.1053605f, -0.0943107f, -0.0833816f, -0.0725707f, -0.0618754f, -0.0512933f, -0.0408220f,
+        -0.0304592f, -0.0202027f, -0.0100503f, 0.0000000f,
+    };
+
+    /*
+      Natural logarithm for x > 0 without libm.
+      x = m * 2^e with m in [sqrt(1/2), sqrt(2)), then ln(m) = 2 * atanh(s), s = (m - 1) / (m + 1),
+      as a 4-term odd series in s (|s| < 0.172). Max relative error 3e-8, below float resolution.
+    */
+    float fastLn(float x)
     {
-        if (!debugMode)
-            return;
+        uint32_t bits;
+        memcpy(&bits, &x, sizeof(bits));
+        int16_t e = (int16_t)((bits >> 23) & 0xFF) - 127;
+        bits = (bits & 0x007FFFFFUL) | 0x3F800000UL; // Mantissa as a float in [1, 2)
+
+        float m;
+        memcpy(&m, &bits, sizeof(m));
+        if (m > 1.41421356f)
+        {
+            m *= 0.5f;
+            e++;
+        }
 
-        va_list args;
-        va_start(args, fmt);
+        float s = (m - 1.0f) / (m + 1.0f);
+        float s2 = s * s;
+        float lnM = 2.0f * s * (1.0f + s2 * (1.0f / 3 + s2 * (1.0f / 5 + s2 * (1.0f / 7))));
+        return e * 0.69314718f + lnM;
+    }
 
-        char buf[256];    // Main buffer
-        char tempBuf[32]; // Temp buffer for float or string conversion
+    float lnRelHumidity(float hum)
+    {
+        uint8_t h = (uint8_t)hum;
+        if (h >= 1 && h <= 100 && h == hum)
+            return pgm_read_float(&lnRelHumidityTable[h - 1]);
+        return fastLn(hum) - 4.60517019f; // ln(hum) - ln(100)
+    }
+}
+#endif
 
-        const char *traverse = fmt;
-        char *bufPtr = buf;
-        int remaining = sizeof(buf);
+/*
+  Dew point using the Magnus formula
+  DHT_FAST_MATH: float kernel with a table/series logarithm, max error 0.0001 °C vs the libm version
+  (-40 to 80 °C, 0.1-100 %RH). Otherwise double precision with libm log().
+  @return Dew point in °C, NaN for 0 %RH
+*/
+double mydht::dewPointC(float tempC, float hum)
+{
+#if DHT_FAST_MATH
+    if (!(hum > 0.0f))
+        return NAN; // ln(0): the libm version yields NaN as well
+
+    const float a = 17.27f;
+    const float b = 237.7f;
+    float alpha = (a * tempC) / (b + tempC) + lnRelHumidity(hum);
+    return (b * alpha) / (a - alpha);
+#else
+    double a = 17.27;
+    double b = 237.7;
+    double alpha = ((a * tempC) / (b + tempC)) + log(hum / 100.0);
+    return (b * alpha) / (a - alpha);
+#endif
+}
 
-        while (*traverse && remaining > 0)
-        {
-            if (*traverse == '%' && *(traverse + 1) == 'f') // float
-            {
-                double f = va_arg(args, double);
-                snprintf(tempBuf, sizeof(tempBuf), "%5.1f", f); // width=5, 1 decimal place
-                int n = snprintf(bufPtr, remaining, "%s", tempBuf);
-                bufPtr += n;
-                remaining -= n;
-                traverse += 2;
-            }
-            else if (*traverse == '%' && *(traverse + 1) == 'd') // integer
-            {
-                int i = va_arg(args, int);
-                int n = snprintf(bufPtr, remaining, "%d", i);
-                bufPtr += n;
-                remaining -= n;
-                traverse += 2;
-            }
-            else if (*traverse == '%' && *(traverse + 1) == 's') // string
-            {
-                const char *s = va_arg(args, const char *);
-                int n = snprintf(bufPtr, remaining, "%s", s);
-                bufPtr += n;
-                remaining -= n;
-                traverse += 2;
-            }
-            else if (*traverse == '%' && *(traverse + 1) == 'X') // hex
-            {
-                int x = va_arg(args, int);
-                int n = snprintf(bufPtr, remaining, "%02X", x); // always 2 digits
-                bufPtr += n;
-                remaining -= n;
-                traverse += 2;
-            }
-            else // ordinary character
-            {
-                *bufPtr++ = *traverse++;
-                remaining--;
-            }
-        }
+/*
+  Heat index ("feels like" temperature)
+  Simple formula below 80°F, full Rothfusz regression above
+  @return Heat index in °F
+*/
+float mydht::heatIndexF(float T, float RH)
+{
+    // Simple formula for HI < 80°F
+    float HI = 0.5 * (T + 61.0 + ((T - 68.0) * 1.2) + (RH * 0.094));
 
-        *bufPtr = '\0';
-        va_end(args);
+    // Apply full Rothfusz regression if HI >= 80°F
+    if (HI >= 80.0)
+    {
+#if DHT_FAST_MATH
+        // Same polynomial as HI = A(RH) + T * (B(RH) + T * C(RH)): 8 multiplies instead of 20,
+        // max difference 0.001 °F from the expanded form (float rounding only)
+        float A = -42.379f + RH * (10.14333127f - 0.05481717f * RH);
+        float B = 2.04901523f + RH * (-0.22475541f + 0.00085282f * RH);
+        float C = -0.00683783f + RH * (0.00122874f - 0.00000199f * RH);
+        HI = A + T * (B + T * C);
+#else
+        HI = -42.379 + 2.04901523 * T + 10.14333127 * RH - 0.22475541 * T * RH - 0.00683783 * T * T - 0.05481717 * RH * RH + 0.00122874 * T * T * RH + 0.00085282 * T * RH * RH - 0.00000199 * T * T * RH * RH;
+#endif
+    }
 
-        Serial.print("[DHT DEBUG] ");
-        Serial.println(buf);
+    return HI;
+}
+
+/*
+  Integer division rounded to nearest, halves away from zero (d > 0)
+*/
+namespace
+{
+    int32_t divRound(int32_t n, int32_t d)
+    {
+        return n >= 0 ? (n + d / 2) / d : -((-n + d / 2) / d);
     }
-}
\ No newline at end of file
+
+    int64_t divRound64(int64_t n, int64_t d)
+    {
+        return n >= 0 ? (n + d / 2) / d : -((-n + d / 2) / d);
+    }
+
+    // ln(1 + i/16) in Q16, i = 0..16 (linear interpolation between entries: max error 5e-4)
+    const uint16_t lnMantissaQ16[17] PROGMEM = {
+        0, 3973, 7719, 11262, 14624, 17821, 20870, 23783, 26573,
+        29248, 31818, 34292, 36675, 38975, 41196, 43345, 45426};
+
+    // ln(x) in Q16 for integer x >= 1
+    int32_t lnQ16(uint16_t x)
+    {
+        uint8_t e = 0;
+        while ((x >> e) > 1)
+            e++;
+
+        // Mantissa x / 2^e in [1, 2) as a Q15 fraction
+        uint16_t frac = (uint16_t)(((uint32_t)x << (15 - e)) - 32768);
+        uint8_t i = frac >> 11;
+        uint16_t rem = frac & 0x7FF;
+        int32_t lo = pgm_read_word(&lnMantissaQ16[i]);
+        int32_t hi = pgm_read_word(&lnMantissaQ16[i + 1]);
+        return e * 45426L + lo + (((hi - lo) * rem) >> 11); // e * ln(2) + ln(mantissa)
+    }
+}
+
+/*
+  Converts tenths of °C to tenths of the requested unit.
+  Kelvin uses +273.2 (273.15 rounded to the nearest tenth).
+*/
+int16_t mydht::fromCelsiusDeci(int16_t tempC10, TempUnit unit)
+{
+    switch (unit)
+    {
+    case Fahrenheit:
+        return divRound((int32_t)tempC10 * 9, 5) + 320;
+    case Kelvin:
+        return tempC10 + 2732;
+    case Celsius:
+    default:
+        return tempC10;
+    }
+}
+
+/*
+  Converts tenths of °F to tenths of the requested unit.
+*/
+int16_t mydht::fromFahrenheitDeci(int16_t tempF10, TempUnit unit)
+{
+    switch (unit)
+    {
+    case Fahrenheit:
+        return tempF10;
+    case Kelvin:
+        return divRound(((int32_t)tempF10 - 320) * 5, 9) + 2732;
+    case Celsius:
+    default:
+        return divRound(((int32_t)tempF10 - 320) * 5, 9);
+    }
+}
+
+/*
+  Dew point, Magnus formula in Q16 fixed point:
+    alpha = 17.27 * T / (237.7 + T) + ln(RH / 100),  Td = 237.7 * alpha / (17.27 - alpha)
+  ln() from a 17-entry table with linear interpolation.
+  Max error 0.06 °C against the double-precision formula, including the rounding to 0.1 °C
+  (-40 to 80 °C, 0.1-100 %RH).
+  @return Dew point in tenths of °C, DHT_FIXED_INVALID for 0 %RH
+*/
+int16_t mydht::dewPointDeciC(int16_t tempC10, uint16_t hum10)
+{
+    if (hum10 == 0)
+        return DHT_FIXED_INVALID;
+
+    const int32_t a = 1131807; // 17.27 in Q16
+    const int32_t b10 = 2377;  // 237.7 in tenths
+
+    int32_t alpha = ((int32_t)tempC10 * a) / (b10 + tempC10) // T and b both in tenths
+                    + lnQ16(hum10) - 452707;                 // ln(hum10 / 1000), ln(1000) in Q16
+    return divRound(b10 * alpha, a - alpha);
+}
+
+/*
+  Heat index, evaluated like heatIndexF() but in integers.
+  The temperature is taken in tenths of °C so that °F is exact in hundredths (T * 1.8 + 32).
+  Coefficients scaled by 1e8 (they have at most 8 decimals) and 64-bit sums:
+  the only error is the final rounding to 0.1 °F.
+  @return Heat index in tenths of °F
+*/
+int16_t mydht::heatIndexDeciF(int16_t tempC10, uint16_t hum10)
+{
+    int32_t t = (int32_t)tempC10 * 18 + 3200; // Hundredths of °F
+    int32_t r = hum10;                         // Tenths of %RH
+
+    // Simple formula: HI = 1.1 T - 10.3 + 0.047 RH
+    int32_t simple = 110 * t - 103000 + 47 * r; // Tenths of °F, scaled by 1000
+    if (simple < 800000)                        // HI < 80 °F
+        return divRound(simple, 1000);
+
+    // Rothfusz regression as A(RH) + T * (B(RH) + T * C(RH)), scaled by 1e14
+    int64_t r64 = r;
+    int64_t A = -4237900000000000LL + 101433312700000LL * r64 - 54817170000LL * r64 * r64;
+    int64_t B = 2049015230000LL - 22475541000LL * r64 + 8528200LL * r64 * r64;
+    int64_t C = -68378300LL + 1228740LL * r64 - 199LL * r64 * r64;
+    int64_t S = A + t * (B + t * C);
+
+    return divRound64(S, 10000000000000LL); // Tenths of °F
+}
+
+#if DHT_METRICS
+void DHTMetrics::reset()
+{
+    *this = DHTMetrics();
+}
+
+void DHTMetrics::add(const DHTMetrics &other)
+{
+    reads += other.reads;
+    successes += other.successes;
+    attempts += other.attempts;
+    retries += other.retries;
+    sanityFallbacks += other.sanityFallbacks;
+    blockingUs += other.blockingUs;
+    for (uint8_t i = 0; i <= DHT_ERROR_INTERNAL; i++)
+        errors[i] += other.errors[i];
+    for (uint8_t i = 0; i < DHT_METRICS_BUCKETS; i++)
+    {
+        uint32_t latency = (uint32_t)latencyUs[i] + other.latencyUs[i];
+        uint32_t ack = (uint32_t)ackUs[i] + other.ackUs[i];
+        latencyUs[i] = latency > 0xFFFF ? 0xFFFF : latency;
+        ackUs[i] = ack > 0xFFFF ? 0xFFFF : ack;
+    }
+}
+
+void DHTMetrics::record(uint16_t *histogram, unsigned long us)
+{
+    uint8_t bucket = 0;
+    while (us && bucket < DHT_METRICS_BUCKETS - 1)
+    {
+        us >>= 1;
+        bucket++;
+    }
+    if (histogram[bucket] < 0xFFFF)
+        histogram[bucket]++;
+}
+
+unsigned long MyDHT::metricsClock() const
+{
+    return micros();
+}
+
+void MyDHT::metricsAttempt(DHTError err)
+{
+    _metrics.attempts++;
+    _metrics.errors[err]++;
+}
+
+/*
+  The ACK phase is what remains of the capture after the 40 bit durations
+*/
+void MyDHT::metricsAck(unsigned long releaseUs, unsigned long endUs)
+{
+    unsigned long bitsUs = 0;
+    for (uint8_t i = 0; i < 40; i++)
+        bitsUs += _lowTimes[i] + _highTimes[i];
+
+    unsigned long captureUs = endUs - releaseUs;
+    DHTMetrics::record(_metrics.ackUs, captureUs > bitsUs ? captureUs - bitsUs : 0);
+}
+
+void MyDHT::metricsRead(unsigned long startUs, uint8_t attempts, DHTError result, bool blocking)
+{
+    unsigned long elapsedUs = micros() - startUs;
+
+    _metrics.reads++;
+    if (result == DHT_OK)
+        _metrics.successes++;
+    if (attempts > 1)
+        _metrics.retries += attempts - 1;
+    if (blocking)
+        _metrics.blockingUs += elapsedUs;
+    DHTMetrics::record(_metrics.latencyUs, elapsedUs);
+}
+
+void MyDHT::metricsSanityFallback()
+{
+    _metrics.sanityFallbacks++;
+}
+
+void MyDHT::metricsBlocking(unsigned long startUs)
+{
+    _metrics.blockingUs += micros() - startUs;
+}
+#endif
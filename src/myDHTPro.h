@@ -2,8 +2,10 @@
 #define MYDHTPRO_H
 
 #include "myDHT_config.h"
+#include "myDHT_history.h"
+#include "myDHT_queue.h"
+#include "myDHT_trace.h"
 #include <Arduino.h>
-#include <stdarg.h> // Needed for variadic debugPrint
 
 // Sensor type
 enum DHTType
@@ -42,12 +44,20 @@ enum TempUnit
   Kelvin
 };
 
-// DHT raw data
+// DHT raw data (copy of the last capture, prefer DHTRawView to avoid the copy)
 struct DHTRawData
 {
   uint8_t bytes[5];
-  unsigned long highTimes[40];
-  unsigned long lowTimes[40];
+  uint8_t highTimes[40]; // HIGH pulse durations in µs, saturated at 255
+  uint8_t lowTimes[40];  // LOW pulse durations in µs, saturated at 255
+};
+
+// Read-only view of the last capture, no copy. Valid until the next read of the same sensor.
+struct DHTRawView
+{
+  const uint8_t *bytes;     // 5 sensor bytes
+  const uint8_t *highTimes; // 40 HIGH pulse durations in µs, saturated at 255
+  const uint8_t *lowTimes;  // 40 LOW pulse durations in µs, saturated at 255
 };
 
 // DHT data
@@ -60,19 +70,55 @@ struct DHTData
   DHTError status;
 };
 
+// Marks a value that could not be computed in DHTFixedData (read error, 0 %RH dew point)
+constexpr int16_t DHT_FIXED_INVALID = -32768;
+constexpr uint16_t DHT_FIXED_INVALID_HUM = 0xFFFF;
+
+// DHT data in fixed point: tenths of the requested unit (235 = 23.5 °C) and tenths of %RH
+struct DHTFixedData
+{
+  int16_t temp;
+  uint16_t hum;
+  int16_t dew;
+  int16_t hi;
+  DHTError status;
+};
+
 // Async callback typedef
 typedef void (*DHTCallback)(DHTData);
 
+class MyDHT;
+
+// Async callback with the sensor and a caller pointer, so one handler can serve many sensors
+typedef void (*DHTContextCallback)(MyDHT &sensor, const DHTData &data, void *context);
+
 // Async states
 enum DHTAsyncState
 {
   IDLE,
   START_SIGNAL,
   WAIT_ACK,
-  READ_BITS_BLOCKING,
-  ERROR_STATE
+  READ_BITS,          // Edge-driven: bits are decoded from interrupt timestamps
+  READ_BITS_BLOCKING, // Fallback for pins without an external interrupt
+  ERROR_STATE,
+  SCHEDULED           // Line idle until the next attempt is due (retry backoff or read interval)
 };
 
+/*
+  Delays between the attempts of an async read (startAsyncRead(), requestRead()).
+  Attempt k + 1 starts firstDelayMs * backoff^(k - 1) ms after attempt k failed, capped at maxDelayMs.
+  The number of attempts is the sensor's retry count (setRetries()).
+*/
+struct DHTRetryPolicy
+{
+  uint16_t firstDelayMs; // 0 = model default (20 ms DHT22, 50 ms DHT11), like read()
+  uint8_t backoff;       // Delay multiplier per failed attempt, 1 = constant delay
+  uint16_t maxDelayMs;
+};
+
+// Edges in one transaction: ACK falling, ACK rising, ACK falling, then a rising+falling pair per bit
+constexpr uint8_t DHT_FRAME_EDGES = 3 + 2 * 40;
+
 // Timings
 struct DHTTimings
 {
@@ -83,6 +129,150 @@ struct DHTTimings
   uint16_t highThresholdUs;
 };
 
+// Bit timing learned by the adaptive mode (setAdaptiveTiming()), see getTimingStats()
+struct DHTTimingStats
+{
+  uint8_t zeroHighUs;       // Mean HIGH width of 0-bits, 0 until learned
+  uint8_t oneHighUs;        // Mean HIGH width of 1-bits, 0 until learned
+  uint16_t highThresholdUs; // Threshold in use
+  uint16_t bitTimeoutUs;    // Bit timeout in use
+  uint16_t learnedFrames;   // Good frames the statistics were built from
+  uint16_t rescuedFrames;   // Checksum failures recovered by re-decoding with the frame's own threshold
+};
+
+#if DHT_METRICS
+// Histogram buckets: bucket k counts durations in [2^(k-1), 2^k) µs, the last one everything longer
+constexpr uint8_t DHT_METRICS_BUCKETS = 20;
+
+// Read statistics of one sensor (DHT_METRICS = 1), see getMetrics()
+struct DHTMetrics
+{
+  uint32_t reads;                          // Reads: read(), async reads, group reads
+  uint32_t successes;                      // Reads that returned DHT_OK (sanity fallbacks included)
+  uint32_t attempts;                       // Sensor transactions, retries included
+  uint32_t retries;                        // Attempts after the first one of a read
+  uint32_t sanityFallbacks;                // Reads answered with the last valid data
+  uint32_t errors[DHT_ERROR_INTERNAL + 1]; // Outcome of every attempt, indexed by DHTError
+  uint32_t blockingUs;                     // Time inside read() and processAsync() (callbacks included)
+  uint16_t latencyUs[DHT_METRICS_BUCKETS]; // Read start to result
+  uint16_t ackUs[DHT_METRICS_BUCKETS];     // Line release to the first data bit (single-sensor captures)
+
+  void reset();
+  void add(const DHTMetrics &other);                   // Adds counters and histograms (aggregates)
+  static void record(uint16_t *histogram, unsigned long us); // Saturating log2-bucket increment
+};
+#endif
+
+/*
+  Compile-time sensor model: protocol timings, decode formulas and plausible ranges.
+  Used by MyDHTTyped<> directly and by MyDHT through a runtime switch on _type.
+*/
+template <DHTType T>
+struct DHTModel;
+
+template <>
+struct DHTModel<DHT11>
+{
+  static constexpr uint16_t startLowMs = 18;      // Pull LOW duration in ms
+  static constexpr uint16_t ackTimeoutUs = 5000;  // ACK timeout in µs
+  static constexpr uint16_t ackDoneUs = 80;       // ACK done threshold
+  static constexpr uint16_t bitTimeoutUs = 200;   // Bit read timeout
+  static constexpr uint16_t highThresholdUs = 50; // HIGH pulse threshold to distinguish 0/1
+
+  static constexpr uint16_t retryDelayMs = 50;
+  static constexpr uint16_t minReadIntervalMs = 1200; // Datasheet allows ~1s, 1.2s is more reliable on real wiring
+  static constexpr float minTempC = DHT11_MIN_TEMP;
+  static constexpr float maxTempC = DHT11_MAX_TEMP;
+
+  static constexpr DHTTimings timings() { return {startLowMs, ackTimeoutUs, ackDoneUs, bitTimeoutUs, highThresholdUs}; }
+
+  // Integer part in bytes[0]/[2], tenths in bytes[1]/[3]
+  static constexpr float humidity(const uint8_t *b) { return b[0] + b[1] / 10.0; }
+  static constexpr float temperatureC(const uint8_t *b) { return b[2] + b[3] / 10.0; }
+
+  // Same values in tenths, integer only (plausibility checks)
+  static constexpr uint16_t humidityTenths(const uint8_t *b) { return b[0] * 10 + b[1]; }
+  static constexpr int16_t temperatureTenths(const uint8_t *b) { return b[2] * 10 + b[3]; }
+};
+
+template <>
+struct DHTModel<DHT22>
+{
+  static constexpr uint16_t startLowMs = 2;
+  static constexpr uint16_t ackTimeoutUs = 3000;
+  static constexpr uint16_t ackDoneUs = 80;
+  static constexpr uint16_t bitTimeoutUs = 200;
+  static constexpr uint16_t highThresholdUs = 48; // Midpoint of 26µs (0) and 70µs (1) edge-to-edge widths
+
+  static constexpr uint16_t retryDelayMs = 20;
+  static constexpr uint16_t minReadIntervalMs = 2000;
+  static constexpr float minTempC = DHT22_MIN_TEMP;
+  static constexpr float maxTempC = DHT22_MAX_TEMP;
+
+  static constexpr DHTTimings timings() { return {startLowMs, ackTimeoutUs, ackDoneUs, bitTimeoutUs, highThresholdUs}; }
+
+  // 16-bit values in tenths, temperature sign in the MSB of bytes[2]
+  static constexpr float humidity(const uint8_t *b) { return ((b[0] << 8) | b[1]) * 0.1; }
+  static constexpr float temperatureC(const uint8_t *b)
+  {
+    return (b[2] & 0x80) ? -(float)((((b[2] & 0x7F) << 8) | b[3]) * 0.1) : (float)((((b[2] & 0x7F) << 8) | b[3]) * 0.1);
+  }
+
+  // Same values in tenths, integer only (plausibility checks)
+  static constexpr uint16_t humidityTenths(const uint8_t *b) { return (b[0] << 8) | b[1]; }
+  static constexpr int16_t temperatureTenths(const uint8_t *b)
+  {
+    return (b[2] & 0x80) ? -(int16_t)(((b[2] & 0x7F) << 8) | b[3]) : (int16_t)(((b[2] & 0x7F) << 8) | b[3]);
+  }
+};
+
+namespace mydht
+{
+  /*
+    Plausibility check on a decoded frame, in integer tenths with no float conversion.
+    Checks the sensor's own reading, before calibration offsets.
+  */
+  template <DHTType T>
+  constexpr bool plausible(const uint8_t *b)
+  {
+    return DHTModel<T>::temperatureTenths(b) >= (int16_t)(DHTModel<T>::minTempC * 10) &&
+           DHTModel<T>::temperatureTenths(b) <= (int16_t)(DHTModel<T>::maxTempC * 10) &&
+           DHTModel<T>::humidityTenths(b) <= (uint16_t)(MAX_HUMIDITY * 10);
+  }
+
+  /*
+    Sensor model that produced a frame (checksum verified), from its layout alone:
+    - DHT22 sends humidity as 16-bit tenths (at most 1000), so byte 0 is 0-3 and the
+      temperature is 16-bit tenths with a sign bit.
+    - DHT11 sends integer %RH in byte 0 (never below 5) and a tenths digit 0-9 in bytes 1 and 3.
+    The byte 0 ranges do not overlap, so one frame decides; DHT_AUTO if it fits neither model.
+  */
+  inline DHTType detectModel(const uint8_t *b)
+  {
+    if (b[0] <= 3)
+      return plausible<DHT22>(b) ? DHT22 : DHT_AUTO;
+    return (b[0] >= 5 && b[1] <= 9 && b[3] <= 9 && plausible<DHT11>(b)) ? DHT11 : DHT_AUTO;
+  }
+
+  // Shared unit conversion and derived-value formulas (used by MyDHT and MyDHTTyped)
+  float fromCelsius(double tempC, TempUnit unit);   // Converts °C to the requested unit
+  float fromFahrenheit(float tempF, TempUnit unit); // Converts °F to the requested unit
+  double dewPointC(float tempC, float hum);         // Magnus formula, result in °C
+  float heatIndexF(float tempF, float hum);         // Rothfusz regression, result in °F
+
+  // Integer versions: temperatures in tenths of a degree, humidity in tenths of %RH
+  int16_t fromCelsiusDeci(int16_t tempC10, TempUnit unit);   // Rounded to the nearest tenth
+  int16_t fromFahrenheitDeci(int16_t tempF10, TempUnit unit); // Rounded to the nearest tenth
+  int16_t dewPointDeciC(int16_t tempC10, uint16_t hum10);     // DHT_FIXED_INVALID for 0 %RH
+  int16_t heatIndexDeciF(int16_t tempC10, uint16_t hum10);    // Rothfusz in 64-bit integers, result in tenths of °F
+
+  const char *errorString(DHTError err); // Human-readable error text (MyDHT::getErrorString, trace rendering)
+}
+
+// Persisted sensor profiles, see myDHT_profile.h
+struct DHTProfile;
+class DHTProfileStorage;
+
 class MyDHT
 {
 public:
@@ -97,6 +287,23 @@ public:
   // Initialize the sensor (set pin mode, etc.)
   void begin();
 
+  /*
+    begin() with a stored profile (myDHT_profile.h): a valid profile for this pin restores type,
+    timing and offsets, so detection is skipped and the wait is getMinReadInterval() instead of 3 s.
+    Without one the sensor starts cold and the detected profile is saved for the next boot.
+    @return true if a profile was loaded
+  */
+  bool begin(DHTProfileStorage &storage, uint16_t address = 0);
+
+  /*
+    Non-blocking begin(): the power-up wait and, for DHT_AUTO, the type detection run in
+    processAsync(), so many sensors start up concurrently. The detection read is the first
+    reading and is delivered to the callback like an async read.
+    isReading() is true until it completes, isStarting() until then as well.
+  */
+  void beginAsync(DHTCallback cb = nullptr);
+  bool isStarting() const { return _starting; } // beginAsync() still waiting or detecting
+
   // Returns last read temperature in Celsius
   float getTemperature(TempUnit unit = Celsius);
 
@@ -116,6 +323,21 @@ public:
   */
   float getHeatIndex(TempUnit unit = Celsius);
 
+  /*
+    Fixed-point API: same values as the float getters, in tenths of the unit, without float math.
+    Temperatures are int16 tenths of a degree, humidity uint16 tenths of %RH.
+  */
+  int16_t getTemperatureDeci(TempUnit unit = Celsius);
+  uint16_t getHumidityDeci();
+  int16_t getDewPointDeci(TempUnit unit = Celsius);
+  int16_t getHeatIndexDeci(TempUnit unit = Celsius);
+
+  // Reads the sensor and returns a fixed-point data package (DHT_FIXED_INVALID values on error)
+  DHTFixedData getFixedData(TempUnit unit = Celsius, bool derived = true);
+
+  // Creates a DHTFixedData struct from the last read bytes
+  DHTFixedData makeFixedData(TempUnit unit = Celsius, bool derived = true);
+
   // Read new data from sensor, returns DHTError
   DHTError read();
 
@@ -123,23 +345,83 @@ public:
   void setRetries(uint8_t retries);
 
   // Adjust calibration offset
-  void setTemperatureOffset(float offsetC);
+  void setTemperatureOffset(float offsetC); // Rounded to tenths, the resolution of the sensors
   void setHumidityOffset(float offset);
+  void setTemperatureOffsetDeci(int16_t offsetC10); // Tenths of °C, no float math
+  void setHumidityOffsetDeci(int16_t offset10);     // Tenths of %RH
+
+  /*
+    Adaptive bit timing: every good frame updates the mean HIGH widths of 0- and 1-bits, and the
+    decode threshold moves to their midpoint (bit timeout follows the longest pulses).
+    Guard rails: learning needs both bit values in a frame, 16 µs between the means and 4 frames;
+    the threshold stays within ±50% of the model default, the bit timeout between the default and 250 µs.
+    A checksum failure is re-decoded once with a threshold fitted to that frame before it counts as failed.
+  */
+  void setAdaptiveTiming(bool enable);
+  DHTTimingStats getTimingStats() const;
+
+  /*
+    Sensor profile: type, retries, calibration offsets and learned timing (include myDHT_profile.h).
+    applyProfile() rejects profiles of another pin; after it begin() / beginAsync() skip the
+    power-up wait beyond getMinReadInterval(). Save again after changing offsets.
+    Precedence: the profile replaces type, retries and offsets set before it (set them after
+    begin(storage) to override), but an explicit setAdaptiveTiming() wins over the profile's flag;
+    its learned timing is then only restored if adaptive timing ends up enabled.
+  */
+  DHTProfile getProfile() const;
+  bool applyProfile(const DHTProfile &profile);
+  bool saveProfile(DHTProfileStorage &storage, uint16_t address = 0) const;
+  bool loadProfile(DHTProfileStorage &storage, uint16_t address = 0); // false if missing, corrupt or another pin
+
+#if DHT_METRICS
+  DHTMetrics getMetrics() const { return _metrics; } // Snapshot of the counters
+  void resetMetrics() { _metrics.reset(); }
+#endif
+
+  // Rolling window fed by every successful read (sync, async, group); nullptr detaches it
+  void setHistory(DHTHistoryBase *history) { _history = history; }
+  DHTHistoryBase *getHistory() const { return _history; }
+
+  // Queue that receives a DHTReading for every completed read (sync, async, group); nullptr detaches it
+  void setQueue(DHTQueueBase *queue) { _queue = queue; }
+  DHTQueueBase *getQueue() const { return _queue; }
 
   // Returns raw data read from the sensor
   DHTRawData getRawData();
 
-  // Returns data package
-  DHTData getData(TempUnit unit = Celsius);
+  // Returns a read-only view of the raw data without copying it
+  DHTRawView getRawView() const;
+
+  // Returns data package; derived = false skips dew point and heat index (left NaN)
+  DHTData getData(TempUnit unit = Celsius, bool derived = true);
 
   // Helper function to create a DHTData struct from the last read bytes
-  DHTData makeData(TempUnit unit = Celsius);
+  DHTData makeData(TempUnit unit = Celsius, bool derived = true);
 
   // Async API
   void startAsyncRead(DHTCallback cb); // Start an asynchronous sensor read
+  void startAsyncRead(DHTContextCallback cb, void *context); // cb gets this sensor and context
   void processAsync();                 // Must be called repeatedly (e.g., in loop()) to advance async read state machine
   bool isReading();                    // Returns true if an asynchronous read is currently in progress
 
+  /*
+    Non-blocking counterpart of readSafe(): the first attempt starts once getMinReadInterval()
+    has passed, failed attempts are retried after the retry policy delay. No call ever waits;
+    drive it with processAsync(). The callback runs once, with the final result.
+    @return false if a read is already in progress
+  */
+  bool requestRead(DHTCallback cb = nullptr);
+  bool requestRead(DHTContextCallback cb, void *context);
+  void setRetryPolicy(const DHTRetryPolicy &policy) { _retryPolicy = policy; }
+  DHTRetryPolicy getRetryPolicy() const { return _retryPolicy; }
+
+  /*
+    Records one line edge for the edge-driven async engine.
+    Called from the pin interrupt; can also be called directly to inject simulated edges.
+    @param timestampUs micros() timestamp of the edge
+  */
+  void onPinEdge(unsigned long timestampUs);
+
   // Getter/Setter for sensor type
   DHTType getType();
   void setType(DHTType type);
@@ -148,7 +430,7 @@ public:
   int getPin() const { return _pin; }
 
   // Minimum wait time between two readings (depends on sensor type)
-  uint16_t getMinReadInterval();
+  uint16_t getMinReadInterval() const;
 
   DHTError getLastError() const;            // Returns the last error occured
   uint16_t getFailureCount() const;         // Returns the number of consecutive read failures
@@ -157,7 +439,7 @@ public:
 
   // static constexpr bool optimizedBuild = DHT_OPTIMIZED_BUILD;
   bool testMode = false;  // If true, enables setRawBytes()
-  bool debugMode = false; // If true, enables debugPrint()
+  bool debugMode = false; // If true, records trace events (see DHTTrace)
 
   // Injects simulated raw sensor bytes for testing (used only when testMode = true)
   void setRawBytes(uint8_t b1, uint8_t b2, uint8_t b3, uint8_t b4, uint8_t b5);
@@ -165,38 +447,111 @@ public:
   // Safe read: enforces getMinReadInterval() timing
   DHTError readSafe();
 
+  // Returns true if getMinReadInterval() has passed since the last read (sync or async) started
+  bool isReadAllowed() const;
+
 private:
+  friend class MultiDHTManagerBase; // Group reads capture into the sensor buffers directly
+  friend class DHTServiceBase;  // Publishes makeReading() snapshots from its own thread
+
   uint8_t _pin;             // Pin where sensor is connected
   DHTType _type = DHT_AUTO; // Sensor type
   uint8_t _retries;         // Number of retries
   DHTTimings _timings;      // Timing parameters depending on sensor type
 
-  float _tempOffsetC = 0.0;    // Calibration offset
-  float _humidityOffset = 0.0; // Humidity offset
+  int16_t _tempOffsetC10 = 0;    // Calibration offset in tenths of °C (float getters convert it)
+  int16_t _humidityOffset10 = 0; // Humidity offset in tenths of %RH
 
   DHTData _lastValidData;         // Last successfully read sensor data
   bool _hasLastValidData = false; // Flag indicating if _lastValidData contains valid data
+  DHTHistoryBase *_history = nullptr;
+
+  DHTQueueBase *_queue = nullptr;
+  uint16_t _sequence = 0; // Completed reads, the sequence number of the last one
+
+  void recordSample();                        // Adds the current sample to _history
+  void publish(DHTError result);              // Counts the completed read and posts it to _queue
+  DHTReading makeReading(DHTError result);    // Record of the read that just completed
+
+  // Adaptive bit timing, widths in 1/16 µs
+  bool _adaptiveTiming = false;
+  bool _adaptiveTimingSet = false; // setAdaptiveTiming() was called: a loaded profile keeps the choice
+  uint16_t _zeroHighQ4 = 0;
+  uint16_t _oneHighQ4 = 0;
+  uint16_t _longestQ4 = 0; // Longest HIGH or LOW pulse per frame
+  uint16_t _learnedFrames = 0;
+  uint16_t _rescuedFrames = 0;
+
+  DHTError checkFrame();  // Checksum of _bytes, with the adaptive rescue and learning
+  bool rescueFrame();     // Re-decodes a failed frame with a threshold fitted to its own widths
+  void learnTiming();     // Updates the statistics and timings from a good frame
+  void resetTiming();     // Model timings, learned statistics cleared
+
+#if DHT_METRICS
+  DHTMetrics _metrics = {};
+  unsigned long _asyncStartUs = 0; // micros() at the first attempt of the running async read
+#endif
+
+  // Metrics hooks; with DHT_METRICS = 0 they are empty inline functions and compile to nothing
+  unsigned long metricsClock() const;
+  void metricsAttempt(DHTError err);
+  void metricsAck(unsigned long releaseUs, unsigned long endUs); // Good capture: ACK phase duration
+  void metricsRead(unsigned long startUs, uint8_t attempts, DHTError result, bool blocking);
+  void metricsSanityFallback();
+  void metricsBlocking(unsigned long startUs);
 
   bool sanityCheck(); // Checks if reading is realistic
 
-  // Low-level read functions
-  int readOneBit(int counter);   // Reads a single bit from the sensor
-  uint8_t readByte(int counter); // Reads a byte (8 bits) from the sensor
-  DHTError readOnce();           // Performs a single read attempt
-  DHTError read5Bytes();         // Reads 5 bytes from the sensor
+  // Dew point and heat index of the current sample, computed on first request
+  enum : uint8_t
+  {
+    DERIVED_DEW_POINT = 1,
+    DERIVED_HEAT_INDEX = 2
+  };
+  uint8_t _derived = 0; // DERIVED_* flags valid for the current sample
+  double _dewPointC;
+  float _heatIndexF;
+
+  // Low-level read functions (protocol loops live in myDHT_protocol.h)
+  DHTError readOnce();               // Performs a single read attempt
+  DHTError read5Bytes();             // Reads 5 bytes from the sensor
+  DHTError decodeCapture();          // Decodes _highTimes into _bytes and verifies the checksum
+  DHTError finishRead(DHTError err); // Sanity check and error bookkeeping of a read attempt
 
   // Last read bytes from the sensor
-  uint8_t _byte1, _byte2, _byte3, _byte4, _byte5;
+  uint8_t _bytes[5];
 
-  // Last read puls duration times
-  unsigned long _highTimes[40];
-  unsigned long _lowTimes[40];
+  // Last read pulse durations in µs (8-bit, saturated)
+  uint8_t _highTimes[40];
+  uint8_t _lowTimes[40];
 
   DHTAsyncState _state = IDLE;     // Current state of the asynchronous read state machine
   DHTCallback _callback = nullptr; // User-provided callback function for async read completion
+  DHTContextCallback _contextCallback = nullptr; // Used instead of _callback when set
+  void *_context = nullptr;        // Passed to _contextCallback
   unsigned long _timer = 0;        // Timer used for measuring delays and timeouts in async reading
-
-  void detectType(); // Detects sensor type DHT11/DHT22
+  DHTError _asyncError = DHT_OK;   // Error reported from ERROR_STATE
+  DHTRetryPolicy _retryPolicy = {0, 2, 1000};
+  uint8_t _asyncAttempt = 0;       // Attempts of the current async read that already failed
+  bool _starting = false;          // beginAsync() has not delivered its first reading yet
+  bool _profileLoaded = false;     // A stored profile was applied: the sensor is known to work
+  unsigned long _scheduledMs = 0;  // millis() at which the SCHEDULED attempt starts
+
+  // Edge-driven async capture (written from the pin interrupt)
+  volatile uint8_t _edgeCount = 0;       // Edges recorded since the line was released
+  volatile unsigned long _edgeLastUs = 0; // Timestamp of the most recent edge
+  uint8_t _asyncBit = 0;                 // Next bit to decode in READ_BITS
+  int8_t _isrSlot = -1;                  // Interrupt trampoline slot, -1 if not attached
+
+  bool attachEdgeCapture();            // Claims an ISR slot and starts recording edges
+  void detachEdgeCapture();            // Stops recording edges and releases the ISR slot
+  void finishAsync(DHTError err);      // Ends the async read and notifies the callback
+  void beginAttempt();                 // Sends the start signal of an async attempt
+  uint16_t retryDelayMs() const;       // Backoff delay before the next async attempt
+
+  void detectType();      // Detects sensor type DHT11/DHT22
+  uint16_t startupDelayMs() const; // Wait of begin() / beginAsync() before the first read
+  bool detectFromFrame(); // Sets the type from the layout of the last frame (DHT_AUTO)
 
   DHTError _lastError = DHT_OK;  // Stores the last error code occured
   uint16_t _failureCount = 0;    // Counts consecutive read failures
@@ -209,6 +564,7 @@ private:
   */
   inline void setError(DHTError err)
   {
+    _derived = 0; // Every read attempt ends here: the sample may have changed
     _lastError = err;
     if (err != DHT_OK)
       _failureCount++;
@@ -216,8 +572,28 @@ private:
       _failureCount = 0;
   }
 
-  //  Prints formatted debug messages to Serial with a "[DHT DEBUG]" prefix
-  void debugPrint(const char *fmt, ...); // Variadic debug print
+  // Records a debug trace event; compiled out in optimized builds
+  inline void trace(DHTTraceEvent event, uint16_t a = 0, uint32_t b = 0)
+  {
+#if !DHT_OPTIMIZED_BUILD
+    if (debugMode)
+      DHTTrace::record(event, _pin, a, b);
+#else
+    (void)event;
+    (void)a;
+    (void)b;
+#endif
+  }
 };
 
+// Metrics compiled out: the hooks are empty and calls to them generate no code
+#if !DHT_METRICS
+inline unsigned long MyDHT::metricsClock() const { return 0; }
+inline void MyDHT::metricsAttempt(DHTError) {}
+inline void MyDHT::metricsAck(unsigned long, unsigned long) {}
+inline void MyDHT::metricsRead(unsigned long, uint8_t, DHTError, bool) {}
+inline void MyDHT::metricsSanityFallback() {}
+inline void MyDHT::metricsBlocking(unsigned long) {}
+#endif
+
 #endif
\ No newline at end of file
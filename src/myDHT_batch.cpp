@@ -0,0 +1,118 @@
+#include "myDHT_batch.h"
+#include <math.h>
+
+namespace
+{
+    // Frames are transposed into columns in blocks of this size, so the per-frame loops
+    // read unit-stride arrays instead of 5-byte records (which compilers do not vectorize).
+    // The block buffers live on the stack: keep them small where RAM is a few KB.
+#if defined(__AVR__)
+    const uint8_t BLOCK = 8;
+#else
+    const uint8_t BLOCK = 64;
+#endif
+
+    struct FrameBlock
+    {
+        uint8_t b[5][BLOCK];
+        uint8_t dht11[BLOCK];
+    };
+}
+
+/*
+  Per block: transpose, then checksum/sanity, temperature and humidity in loops without calls or
+  early exits. The log()-based dew point and heat index run afterwards, for the valid frames only.
+
+  The integer checksum/sanity loop always runs over a whole block (a partial block is zero-padded)
+  into a local array: a fixed trip count and no aliasing with the outputs are what GCC's cheap
+  vectorizer cost model (-O2, GCC 12+) needs. Hosts with SIMD (x86-64, AArch64) vectorize it at -O2
+  and -O3; -Os and the Arduino cores' MCUs (no SIMD units) run it as plain scalar code.
+*/
+size_t mydht::convertFrames(const uint8_t (*frames)[5], const DHTType *types, size_t n, const DHTBatchOutput &out,
+                            TempUnit unit, float tempOffsetC, float humOffset)
+{
+    uint8_t *valid = out.valid; // Local copies: stores through out.* could alias the struct
+    float *tempOut = out.temp;
+    float *humOut = out.hum;
+    float *dewOut = out.dew;
+    float *hiOut = out.hi;
+
+    size_t validCount = 0;
+    FrameBlock blk;
+    uint8_t okBlk[BLOCK];
+    float tempC[BLOCK];
+    float hum[BLOCK];
+
+    for (size_t base = 0; base < n; base += BLOCK)
+    {
+        uint8_t m = (n - base < BLOCK) ? (uint8_t)(n - base) : BLOCK;
+
+        for (uint8_t i = 0; i < m; i++)
+        {
+            for (uint8_t j = 0; j < 5; j++)
+                blk.b[j][i] = frames[base + i][j];
+            blk.dht11[i] = types[base + i] == DHT11;
+        }
+        for (uint8_t i = m; i < BLOCK; i++)
+        {
+            for (uint8_t j = 0; j < 5; j++)
+                blk.b[j][i] = 0;
+            blk.dht11[i] = 0;
+        }
+
+        const uint8_t *b0 = blk.b[0], *b1 = blk.b[1], *b2 = blk.b[2], *b3 = blk.b[3], *b4 = blk.b[4];
+
+        // Checksum and sanity check on the integer fields: mydht::plausible<T>() with selects instead of branches
+        for (uint8_t i = 0; i < BLOCK; i++)
+        {
+            bool dht11 = blk.dht11[i];
+            int16_t t22 = ((b2[i] & 0x7F) << 8) | b3[i];
+            int16_t temp = dht11 ? (int16_t)(b2[i] * 10 + b3[i]) : ((b2[i] & 0x80) ? -t22 : t22);
+            uint16_t h = dht11 ? (uint16_t)(b0[i] * 10 + b1[i]) : (uint16_t)((b0[i] << 8) | b1[i]);
+            int16_t minTemp = dht11 ? (int16_t)(DHTModel<DHT11>::minTempC * 10) : (int16_t)(DHTModel<DHT22>::minTempC * 10);
+            int16_t maxTemp = dht11 ? (int16_t)(DHTModel<DHT11>::maxTempC * 10) : (int16_t)(DHTModel<DHT22>::maxTempC * 10);
+
+            okBlk[i] = ((uint8_t)(b0[i] + b1[i] + b2[i] + b3[i]) == b4[i]) & (temp >= minTemp) & (temp <= maxTemp) &
+                       (h <= (uint16_t)(MAX_HUMIDITY * 10));
+        }
+
+        for (uint8_t i = 0; i < m; i++)
+        {
+            valid[base + i] = okBlk[i];
+            validCount += okBlk[i];
+        }
+
+        // Temperature and humidity, same expressions as DHTModel<T> and MyDHT::getTemperature() / getHumidity()
+        for (uint8_t i = 0; i < m; i++)
+        {
+            bool dht11 = blk.dht11[i];
+            float t11 = b2[i] + b3[i] / 10.0;
+            float t22 = (float)((((b2[i] & 0x7F) << 8) | b3[i]) * 0.1);
+            float t = dht11 ? t11 : ((b2[i] & 0x80) ? -t22 : t22);
+            tempC[i] = t + tempOffsetC; // Both models computed, then selected: no branches
+
+            float h11 = b0[i] + b1[i] / 10.0;
+            float h22 = ((b0[i] << 8) | b1[i]) * 0.1;
+            float h = (dht11 ? h11 : h22) + humOffset;
+            h = h < 0.0f ? 0.0f : h;
+            hum[i] = h > 100.0f ? 100.0f : h;
+        }
+
+        for (uint8_t i = 0; i < m; i++)
+        {
+            bool ok = valid[base + i];
+            if (tempOut)
+                tempOut[base + i] = ok ? mydht::fromCelsius(tempC[i], unit) : NAN;
+            if (humOut)
+                humOut[base + i] = ok ? hum[i] : NAN;
+
+            // Dew point and heat index as MyDHT::getDewPoint() / getHeatIndex()
+            if (dewOut)
+                dewOut[base + i] = ok ? mydht::fromCelsius(mydht::dewPointC(tempC[i], hum[i]), unit) : NAN;
+            if (hiOut)
+                hiOut[base + i] = ok ? mydht::fromFahrenheit(mydht::heatIndexF(mydht::fromCelsius(tempC[i], Fahrenheit), hum[i]), unit) : NAN;
+        }
+    }
+
+    return validCount;
+}
@@ -0,0 +1,41 @@
+#ifndef MYDHT_BATCH_H
+#define MYDHT_BATCH_H
+
+#include "myDHTPro.h"
+#include <stddef.h>
+
+/*
+  Batch conversion of raw 5-byte frames, e.g. frames forwarded by field nodes to a gateway.
+
+  Input is an array of frames with one DHTType per frame (DHT_AUTO decodes as DHT22, like MyDHT).
+  Output is structure-of-arrays: valid is required, the value columns may be nullptr to skip them.
+  Checksum and sanity checks run first in a branch-free loop over all frames, then temperature
+  and humidity, then dew point and heat index for the valid frames only.
+
+  Values are bit-identical to MyDHT::makeData() for a sensor of the same type with the same offsets.
+  Invalid frames (checksum or sanity failure) get valid = 0 and NaN values.
+*/
+struct DHTBatchOutput
+{
+  uint8_t *valid; // Required: 1 if checksum and sanity check passed
+  float *temp;    // Temperature in the requested unit
+  float *hum;     // Relative humidity in %, clamped to 0–100%
+  float *dew;     // Dew point in the requested unit
+  float *hi;      // Heat index in the requested unit
+};
+
+namespace mydht
+{
+  /*
+    @param frames       n raw frames (bytes[0..4] as read from the sensor)
+    @param types        Sensor type of each frame
+    @param unit         Temperature unit of temp, dew and hi
+    @param tempOffsetC  Calibration offset applied to every frame, as MyDHT::setTemperatureOffset()
+    @param humOffset    Calibration offset applied to every frame, as MyDHT::setHumidityOffset()
+    @return Number of valid frames
+  */
+  size_t convertFrames(const uint8_t (*frames)[5], const DHTType *types, size_t n, const DHTBatchOutput &out,
+                       TempUnit unit = Celsius, float tempOffsetC = 0.0f, float humOffset = 0.0f);
+}
+
+#endif
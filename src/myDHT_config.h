@@ -2,8 +2,45 @@
 
 // Single source of truth: do NOT override this macro in sketches.
 // Change it here if you want an optimized build.
+// The optimized build drops test mode, debug output and the last-valid-data fallback, and async
+// reads (startAsyncRead(), requestRead(), beginAsync()) capture without the pin interrupt: they keep
+// their schedule, retries and callback, but each attempt blocks processAsync() for about 5 ms.
 #define DHT_OPTIMIZED_BUILD 0 // 0 = normal, 1 = optimized
 
+// 1 = read the data line through cached port registers on AVR, SAMD, ESP32 and ESP8266
+// 0 = always use digitalRead() (any other core uses it regardless)
+#define DHT_FAST_GPIO 1
+
+// 1 = float dew point / heat index kernels (table + series log, Horner-form Rothfusz), max error 0.001 °F
+// 0 = reference formulas with libm log() in double precision
+#define DHT_FAST_MATH 1
+
+// Number of sensors that can run an edge-driven async read at the same time (max 4).
+// Further sensors, and pins without an external interrupt, fall back to the blocking bit reader.
+#define DHT_ASYNC_ISR_SLOTS 4
+
+// Maximum number of sensors on one GPIO port captured together by MultiDHTManager group reads
+#define DHT_GROUP_MAX_PINS 8
+
+// 1 = per-sensor counters and latency histograms (getMetrics(), about 140 bytes per sensor)
+// 0 = metrics compiled out: no RAM and no code
+#define DHT_METRICS 0
+
+// Background sensor service (DHTService): a FreeRTOS task on ESP32, std::thread in a host build.
+// Other cores have no threads to run it on, so it is not compiled there.
+#if defined(ESP32) || !defined(ARDUINO)
+#define DHT_SERVICE 1
+#else
+#define DHT_SERVICE 0
+#endif
+
+// Interrupt handlers must live in IRAM on ESP targets
+#if defined(ESP32) || defined(ESP8266)
+#define DHT_ISR_ATTR IRAM_ATTR
+#else
+#define DHT_ISR_ATTR
+#endif
+
 namespace mydht
 {
     constexpr bool optimizedBuild()
@@ -0,0 +1,170 @@
+#include "myDHT_history.h"
+#include <math.h>
+
+DHTHistoryBase::DHTHistoryBase(int16_t *values, uint16_t *deques, uint16_t capacity) : _capacity(capacity)
+{
+    _values[0] = values;
+    _values[1] = values + capacity;
+    for (uint8_t d = 0; d < 4; d++)
+        _deques[d].slots = deques + d * capacity;
+    clear();
+}
+
+void DHTHistoryBase::clear()
+{
+    _head = 0;
+    _count = 0;
+    for (uint8_t ch = 0; ch < 2; ch++)
+    {
+        _sum[ch] = 0;
+        _sumSq[ch] = 0;
+        _sumIndexed[ch] = 0;
+        _emaQ8[ch] = 0;
+    }
+    _emaStarted = false;
+    for (uint8_t d = 0; d < 4; d++)
+    {
+        _deques[d].head = 0;
+        _deques[d].size = 0;
+    }
+}
+
+/*
+  Adds one sample. Amortized O(1): each ring position enters and leaves every deque at most once.
+*/
+void DHTHistoryBase::add(int16_t tempC10, uint16_t hum10)
+{
+    int16_t sample[2] = {tempC10, (int16_t)hum10};
+    uint16_t slot;
+
+    if (_count == _capacity)
+    {
+        slot = _head; // Oldest sample makes room for the new one
+        for (uint8_t ch = 0; ch < 2; ch++)
+            evict(ch, slot, _values[ch][slot]);
+        _head = (_head + 1 == _capacity) ? 0 : _head + 1;
+        _count--;
+    }
+    else
+    {
+        slot = _head + _count;
+        if (slot >= _capacity)
+            slot -= _capacity;
+    }
+
+    for (uint8_t ch = 0; ch < 2; ch++)
+        push(ch, slot, sample[ch]);
+    _count++;
+    _emaStarted = true;
+}
+
+/*
+  Removes the oldest sample from the sums and deques. Every remaining sample moves one
+  position closer to the start of the window, so the index-weighted sum drops by their sum.
+*/
+void DHTHistoryBase::evict(uint8_t ch, uint16_t slot, int16_t value)
+{
+    _sum[ch] -= value;
+    _sumSq[ch] -= (uint32_t)((int32_t)value * value);
+    _sumIndexed[ch] -= _sum[ch];
+
+    for (uint8_t d = ch * 2; d < ch * 2 + 2; d++)
+    {
+        Deque &q = _deques[d];
+        if (q.size > 0 && q.slots[q.head] == slot)
+        {
+            q.head = (q.head + 1 == _capacity) ? 0 : q.head + 1;
+            q.size--;
+        }
+    }
+}
+
+void DHTHistoryBase::push(uint8_t ch, uint16_t slot, int16_t value)
+{
+    _values[ch][slot] = value;
+    _sumIndexed[ch] += (int64_t)_count * value;
+    _sum[ch] += value;
+    _sumSq[ch] += (uint32_t)((int32_t)value * value);
+
+    // EMA in tenths * 256: alpha * difference stays below 2^27, the division truncates toward zero
+    int32_t valueQ8 = (int32_t)value * 256;
+    if (_emaStarted)
+        _emaQ8[ch] += (int32_t)_emaAlpha256 * (valueQ8 - _emaQ8[ch]) / 256;
+    else
+        _emaQ8[ch] = valueQ8;
+
+    // Min deque keeps increasing values, max deque decreasing: drop entries the new sample outlives
+    for (uint8_t d = ch * 2; d < ch * 2 + 2; d++)
+    {
+        Deque &q = _deques[d];
+        bool isMax = d & 1;
+        while (q.size > 0)
+        {
+            uint16_t back = q.head + q.size - 1;
+            if (back >= _capacity)
+                back -= _capacity;
+            int16_t backValue = _values[ch][q.slots[back]];
+            if (isMax ? backValue > value : backValue < value)
+                break;
+            q.size--;
+        }
+
+        uint16_t tail = q.head + q.size;
+        if (tail >= _capacity)
+            tail -= _capacity;
+        q.slots[tail] = slot;
+        q.size++;
+    }
+}
+
+float DHTHistoryBase::getMin(DHTChannel ch) const
+{
+    return _count ? _values[ch][front(ch * 2)] / 10.0f : NAN;
+}
+
+float DHTHistoryBase::getMax(DHTChannel ch) const
+{
+    return _count ? _values[ch][front(ch * 2 + 1)] / 10.0f : NAN;
+}
+
+float DHTHistoryBase::getMean(DHTChannel ch) const
+{
+    return _count ? _sum[ch] / (10.0f * _count) : NAN;
+}
+
+float DHTHistoryBase::getVariance(DHTChannel ch) const
+{
+    if (!_count)
+        return NAN;
+
+    // n * sum(x^2) - sum(x)^2 is exact in 64 bits
+    int64_t n = _count;
+    int64_t num = n * (int64_t)_sumSq[ch] - (int64_t)_sum[ch] * _sum[ch];
+    return (float)num / ((float)(n * n) * 100.0f);
+}
+
+float DHTHistoryBase::getTrend(DHTChannel ch) const
+{
+    if (_count < 2)
+        return 0.0f;
+
+    // Least-squares slope with x = 0..n-1: (n Sxy - Sx Sy) / (n Sxx - Sx^2)
+    int64_t n = _count;
+    int64_t sx = n * (n - 1) / 2;
+    int64_t num = n * _sumIndexed[ch] - sx * _sum[ch];
+    int64_t den = n * n * (n * n - 1) / 12;
+    return (float)num / ((float)den * 10.0f);
+}
+
+float DHTHistoryBase::getEMA(DHTChannel ch) const
+{
+    return _emaStarted ? _emaQ8[ch] / 2560.0f : NAN;
+}
+
+int16_t DHTHistoryBase::getSample(DHTChannel ch, uint16_t age) const
+{
+    uint16_t slot = _head + (_count - 1 - age);
+    if (slot >= _capacity)
+        slot -= _capacity;
+    return _values[ch][slot];
+}
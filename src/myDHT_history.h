@@ -0,0 +1,100 @@
+#ifndef MYDHT_HISTORY_H
+#define MYDHT_HISTORY_H
+
+#include <stdint.h>
+
+// Quantity tracked by a DHTHistory
+enum DHTChannel
+{
+  DHT_TEMPERATURE = 0, // °C, including the sensor's calibration offset
+  DHT_HUMIDITY = 1     // %RH, including the calibration offset, clamped to 0–100%
+};
+
+/*
+  Rolling window over the last N readings of one sensor, with statistics updated on every sample.
+
+  Samples are stored in tenths (4 bytes each). Every query runs in constant time:
+    - min / max   monotonic deques of ring positions (the front is the current extreme)
+    - mean / var  exact integer sums and sums of squares, no floating-point drift
+    - trend       least-squares slope over the window, from a running index-weighted sum
+    - EMA         exponential moving average over all samples since clear(), in fixed point
+  Updates use integer math only; floats appear in the getters, so a sketch that attaches no
+  history, or only reads samples back, links no float code through it.
+
+  Attach to a sensor with MyDHT::setHistory(); each successful read() or async read then adds
+  its sample. Storage comes from DHTHistory<N>, this base class holds the shared code.
+*/
+class DHTHistoryBase
+{
+public:
+  void add(int16_t tempC10, uint16_t hum10); // Adds a sample in tenths; evicts the oldest when full
+  void clear();
+
+  uint16_t getCount() const { return _count; }
+  uint16_t getCapacity() const { return _capacity; }
+  bool isFull() const { return _count == _capacity; }
+
+  // Statistics of the current window, NaN while it is empty
+  float getMin(DHTChannel ch) const;
+  float getMax(DHTChannel ch) const;
+  float getMean(DHTChannel ch) const;
+  float getVariance(DHTChannel ch) const; // Population variance
+  float getTrend(DHTChannel ch) const;    // Slope per sample (°C or %RH), 0 with fewer than 2 samples
+  float getEMA(DHTChannel ch) const;
+
+  // Weight of the newest sample (default 0.2), kept in steps of 1/256
+  void setEmaAlpha(float alpha) { setEmaAlphaQ8(alpha * 256 + 0.5f); }
+  void setEmaAlphaQ8(uint16_t alpha256) { _emaAlpha256 = alpha256 > 256 ? 256 : alpha256; } // alpha * 256
+
+  // Oldest sample is age = getCount() - 1, the newest is age 0; values in tenths
+  int16_t getSample(DHTChannel ch, uint16_t age) const;
+
+protected:
+  // Per channel: the window ring and two deques of ring positions, each of capacity entries
+  DHTHistoryBase(int16_t *values, uint16_t *deques, uint16_t capacity);
+
+private:
+  // Index of a deque: channel * 2 + (0 = min, 1 = max)
+  struct Deque
+  {
+    uint16_t *slots;
+    uint16_t head;
+    uint16_t size;
+  };
+
+  int16_t *_values[2];
+  Deque _deques[4];
+  uint16_t _capacity;
+  uint16_t _head = 0; // Ring position of the oldest sample
+  uint16_t _count = 0;
+
+  int32_t _sum[2];
+  uint32_t _sumSq[2];
+  int64_t _sumIndexed[2]; // sum of k * x_k, k = 0 for the oldest sample
+  int32_t _emaQ8[2];          // EMA in tenths * 256
+  uint16_t _emaAlpha256 = 51; // 0.2 * 256
+  bool _emaStarted;           // A sample has arrived since clear()
+
+  void push(uint8_t ch, uint16_t slot, int16_t value);
+  void evict(uint8_t ch, uint16_t slot, int16_t value);
+  uint16_t front(uint8_t deque) const { return _deques[deque].slots[_deques[deque].head]; }
+};
+
+/*
+  History of N samples, 12 * N bytes plus about 70 bytes of state.
+  @tparam N Window size, up to 4096 (keeps the integer sums within 32 bits)
+*/
+template <uint16_t N>
+class DHTHistory : public DHTHistoryBase
+{
+  static_assert(N >= 1 && N <= 4096, "DHTHistory window must hold 1 to 4096 samples");
+
+public:
+  DHTHistory() : DHTHistoryBase(_valueStorage, _dequeStorage, N) {}
+
+private:
+  int16_t _valueStorage[2 * N];
+  uint16_t _dequeStorage[4 * N];
+};
+
+#endif
@@ -0,0 +1,234 @@
+#include "myDHT_log.h"
+#include "myDHT_batch.h"
+#include <string.h>
+
+namespace
+{
+    const uint8_t TAG_FRAME = 0x20;
+    const uint8_t TAG_DHT11 = 0x10;
+    const uint8_t TAG_STATUS = 0x07;
+
+    uint8_t sampleTag(DHTType type, DHTError status, bool hasFrame)
+    {
+        return (DHT_LOG_SAMPLE << 6) | (hasFrame ? TAG_FRAME : 0) | (type == DHT11 ? TAG_DHT11 : 0) | (status & TAG_STATUS);
+    }
+
+    // Frame bytes stored for a status: the checksum of a good frame is implied, timeouts have no frame
+    uint8_t frameLength(uint8_t tag)
+    {
+        if (!(tag & TAG_FRAME))
+            return 0;
+        return ((tag & TAG_STATUS) == DHT_OK) ? 4 : 5;
+    }
+
+    // Sample tag, sensor id and frame bytes
+    uint8_t putEntry(uint8_t *buf, uint8_t id, DHTType type, DHTError status, const uint8_t *bytes)
+    {
+        bool hasFrame = bytes && (status == DHT_OK || status == DHT_ERROR_CHECKSUM || status == DHT_ERROR_SANITY);
+        uint8_t tag = sampleTag(type, status, hasFrame);
+        uint8_t n = 0;
+
+        buf[n++] = tag;
+        buf[n++] = id;
+        uint8_t len = frameLength(tag);
+        memcpy(buf + n, bytes, len);
+        return n + len;
+    }
+
+    uint8_t putVarint(uint8_t *buf, unsigned long value)
+    {
+        uint8_t n = 0;
+        while (value >= 0x80)
+        {
+            buf[n++] = (uint8_t)value | 0x80;
+            value >>= 7;
+        }
+        buf[n++] = (uint8_t)value;
+        return n;
+    }
+
+    // Returns the bytes used, 0 if the varint is incomplete
+    size_t getVarint(const uint8_t *data, size_t len, unsigned long &value)
+    {
+        value = 0;
+        for (size_t i = 0; i < len && i < 5; i++)
+        {
+            value |= (unsigned long)(data[i] & 0x7F) << (7 * i);
+            if (!(data[i] & 0x80))
+                return i + 1;
+        }
+        return 0;
+    }
+}
+
+uint8_t DHTLogEncoder::putHeader(uint8_t *buf, uint8_t tag, unsigned long ms)
+{
+    uint8_t n = 0;
+    if (!_started)
+    {
+        // Absolute time once per stream, deltas afterwards
+        buf[n++] = DHT_LOG_TIME << 6;
+        for (uint8_t i = 0; i < 4; i++)
+            buf[n++] = (uint8_t)(ms >> (8 * i));
+        _lastMs = ms;
+        _started = true;
+    }
+
+    buf[n++] = tag;
+    n += putVarint(buf + n, ms - _lastMs); // Unsigned difference stays right across the millis() rollover
+    _lastMs = ms;
+    return n;
+}
+
+size_t DHTLogEncoder::emit(const uint8_t *buf, size_t len)
+{
+    size_t written = _out.write(buf, len);
+    _bytesWritten += written;
+    return written;
+}
+
+size_t DHTLogEncoder::writeSample(uint8_t id, DHTType type, DHTError status, const uint8_t *bytes, unsigned long ms)
+{
+    uint8_t buf[5 + DHT_LOG_MAX_SAMPLE_BYTES]; // Time record + sample
+    uint8_t entry[7];
+    uint8_t entryLen = putEntry(entry, id, type, status, bytes);
+
+    // A single sample is tag, delta, then the entry without its tag
+    uint8_t n = putHeader(buf, entry[0], ms);
+    memcpy(buf + n, entry + 1, entryLen - 1);
+    _samplesWritten++;
+    return emit(buf, n + entryLen - 1);
+}
+
+size_t DHTLogEncoder::writeSample(uint8_t id, MyDHT &sensor)
+{
+    return writeSample(id, sensor.getType(), sensor.getLastError(), sensor.getRawView().bytes, millis());
+}
+
+size_t DHTLogEncoder::writeSweep(MultiDHTManagerBase &manager, const DHTResult results[])
+{
+    uint8_t entries = 0;
+    for (int i = 0; i < manager.getCount(); i++)
+        entries += results[i].ready;
+
+    uint8_t buf[5 + DHT_LOG_MAX_SAMPLE_BYTES];
+    uint8_t n = putHeader(buf, DHT_LOG_SWEEP << 6, millis());
+    buf[n++] = entries;
+    size_t written = emit(buf, n);
+
+    // One write per entry keeps the stack buffer independent of the sensor count
+    for (int i = 0; i < manager.getCount(); i++)
+    {
+        if (!results[i].ready)
+            continue;
+
+        // A sanity failure covered by the last valid data reports DHT_OK: log what the frame was
+        MyDHT *s = manager.getSensor(i);
+        DHTError status = (results[i].error == DHT_OK) ? s->getLastError() : results[i].error;
+        n = putEntry(buf, (uint8_t)i, s->getType(), status, s->getRawView().bytes);
+        written += emit(buf, n);
+        _samplesWritten++;
+    }
+    return written;
+}
+
+size_t DHTLogDecoder::decodeEntry(const uint8_t *data, size_t len, uint8_t tag, DHTLogRecord &rec)
+{
+    uint8_t frameLen = frameLength(tag);
+    if (len < 1u + frameLen)
+        return 0;
+
+    rec.id = data[0];
+    rec.type = (tag & TAG_DHT11) ? DHT11 : DHT22;
+    rec.status = (DHTError)(tag & TAG_STATUS);
+    rec.hasFrame = frameLen > 0;
+    memset(rec.bytes, 0, sizeof(rec.bytes));
+    memcpy(rec.bytes, data + 1, frameLen);
+    if (frameLen == 4)
+        rec.bytes[4] = rec.bytes[0] + rec.bytes[1] + rec.bytes[2] + rec.bytes[3]; // Implied checksum
+    return 1 + frameLen;
+}
+
+bool DHTLogDecoder::next(const uint8_t *data, size_t len, size_t &used, DHTLogRecord &rec)
+{
+    used = 0;
+    if (_corrupt || len == 0)
+        return false;
+
+    if (_sweepLeft > 0)
+    {
+        // Sweep entry: tag, id, frame
+        size_t n = decodeEntry(data + 1, len - 1, data[0], rec);
+        if (n == 0)
+            return false;
+
+        rec.timeMs = _timeMs;
+        rec.sweepSize = _sweepSize;
+        rec.sweepIndex = _sweepSize - _sweepLeft;
+        _sweepLeft--;
+        used = 1 + n;
+        return true;
+    }
+
+    uint8_t tag = data[0];
+    uint8_t kind = tag >> 6;
+
+    if (kind == DHT_LOG_TIME)
+    {
+        if (len < 5)
+            return false;
+        _timeMs = (unsigned long)data[1] | ((unsigned long)data[2] << 8) | ((unsigned long)data[3] << 16) |
+                  ((unsigned long)data[4] << 24);
+        used = 5;
+        return false;
+    }
+
+    if (kind != DHT_LOG_SAMPLE && kind != DHT_LOG_SWEEP)
+    {
+        _corrupt = true;
+        return false;
+    }
+
+    unsigned long delta;
+    size_t n = getVarint(data + 1, len - 1, delta);
+    if (n == 0)
+        return false;
+    n += 1;
+
+    if (kind == DHT_LOG_SWEEP)
+    {
+        if (len < n + 1)
+            return false;
+        _timeMs += delta;
+        _sweepSize = _sweepLeft = data[n];
+        used = n + 1;
+        return false;
+    }
+
+    size_t entry = decodeEntry(data + n, len - n, tag, rec);
+    if (entry == 0)
+        return false;
+
+    _timeMs += delta;
+    rec.timeMs = _timeMs;
+    rec.sweepIndex = 0;
+    rec.sweepSize = 0;
+    used = n + entry;
+    return true;
+}
+
+/*
+  Same conversion as the sensor classes, through mydht::convertFrames(): the values match
+  MyDHT::makeData() for the same frame, type and offsets.
+*/
+DHTData DHTLogDecoder::toData(const DHTLogRecord &rec, TempUnit unit, float tempOffsetC, float humOffset)
+{
+    DHTData data = {NAN, NAN, NAN, NAN, rec.status};
+    if (rec.status != DHT_OK || !rec.hasFrame)
+        return data;
+
+    uint8_t valid;
+    DHTBatchOutput out = {&valid, &data.temp, &data.hum, &data.dew, &data.hi};
+    mydht::convertFrames(&rec.bytes, &rec.type, 1, out, unit, tempOffsetC, humOffset);
+    return data;
+}
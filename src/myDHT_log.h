@@ -0,0 +1,118 @@
+#ifndef MYDHT_LOG_H
+#define MYDHT_LOG_H
+
+#include "myDHTPro.h"
+#include "MultiDHTManager.h"
+#include <stddef.h>
+
+/*
+  Compact binary log records for readings and raw frames.
+
+  A stream is a sequence of records, each starting with a tag byte:
+
+    bits 7-6  kind: 0 = sample, 1 = sweep, 2 = time
+    bit 5     frame follows              (sample)
+    bit 4     DHT11 frame, else DHT22    (sample)
+    bits 2-0  DHTError status            (sample)
+
+  Time    tag, then the absolute millis() as 4 bytes little-endian. Written before the first
+          sample of a stream; every other record carries the delta to the previous one.
+  Sample  tag, time delta (varint ms), sensor id, frame.
+  Sweep   tag, time delta (varint ms), entry count, then per entry: sample tag, sensor id, frame.
+
+  The time delta is an unsigned LEB128 varint (7 bits per byte): 2 bytes up to 16 s.
+  Frames are the raw sensor bytes. For DHT_OK the checksum byte is left out (it is implied),
+  failed checksum and sanity frames keep all 5 bytes, timeouts store none.
+  A successful sample at a 2 s interval is 8 bytes; a sweep of N sensors is 4 + 6 * N bytes.
+*/
+
+enum DHTLogKind
+{
+  DHT_LOG_SAMPLE = 0,
+  DHT_LOG_SWEEP = 1,
+  DHT_LOG_TIME = 2
+};
+
+// Largest encoded record except sweeps: tag, 5-byte varint, id, 5 frame bytes
+#define DHT_LOG_MAX_SAMPLE_BYTES 12
+
+/*
+  Writes log records to any Print (Serial, a file, a radio buffer) without heap allocation.
+  Each record is assembled on the stack and handed to Print::write() in one call.
+*/
+class DHTLogEncoder
+{
+public:
+  DHTLogEncoder(Print &out) : _out(out) {}
+
+  // Encodes one reading; returns the bytes written
+  size_t writeSample(uint8_t id, DHTType type, DHTError status, const uint8_t *bytes, unsigned long ms);
+  size_t writeSample(uint8_t id, MyDHT &sensor); // Last result of sensor, stamped with millis()
+
+  /*
+    Encodes the finished entries (ready == true) of a MultiDHTManager sweep or readAll() as one record.
+    The sensor id of each entry is its index in the manager. Entries carry the status of the frame
+    itself, so a sanity failure that the manager reported as DHT_OK (last valid data) logs as
+    DHT_ERROR_SANITY, like writeSample(id, sensor).
+  */
+  size_t writeSweep(MultiDHTManagerBase &manager, const DHTResult results[]);
+
+  void restart() { _started = false; } // Next record starts with an absolute time record
+
+  unsigned long getBytesWritten() const { return _bytesWritten; }
+  unsigned long getSamplesWritten() const { return _samplesWritten; }
+
+private:
+  Print &_out;
+  unsigned long _lastMs = 0;
+  bool _started = false;
+  unsigned long _bytesWritten = 0;
+  unsigned long _samplesWritten = 0;
+
+  uint8_t putHeader(uint8_t *buf, uint8_t tag, unsigned long ms); // Time record (if needed), tag and delta
+  size_t emit(const uint8_t *buf, size_t len);
+};
+
+// One decoded sample; sweep entries share the time of their sweep
+struct DHTLogRecord
+{
+  unsigned long timeMs;
+  uint8_t id;
+  DHTType type;
+  DHTError status;
+  bool hasFrame;
+  uint8_t bytes[5];
+  uint8_t sweepIndex; // Position in the sweep, 0 for single samples
+  uint8_t sweepSize;  // Entries in the sweep, 0 for single samples
+};
+
+/*
+  Streaming decoder. Uses no pin or timing functions, so it also runs on a host
+  (see extras/dhtlog for a command-line converter).
+*/
+class DHTLogDecoder
+{
+public:
+  /*
+    Decodes the next item at data (a record, or one entry of a sweep).
+    @param used Bytes consumed, 0 if more data is needed (nothing is consumed then)
+    @return true if rec was filled; time records and sweep headers consume bytes without a sample
+  */
+  bool next(const uint8_t *data, size_t len, size_t &used, DHTLogRecord &rec);
+
+  bool isCorrupt() const { return _corrupt; } // Unknown record kind seen; decoding stopped
+
+  // Converts a sample as MyDHT::makeData() would, with the sensor's calibration offsets if known
+  static DHTData toData(const DHTLogRecord &rec, TempUnit unit = Celsius, float tempOffsetC = 0.0f,
+                        float humOffset = 0.0f);
+
+private:
+  unsigned long _timeMs = 0;
+  uint8_t _sweepSize = 0;
+  uint8_t _sweepLeft = 0;
+  bool _corrupt = false;
+
+  static size_t decodeEntry(const uint8_t *data, size_t len, uint8_t tag, DHTLogRecord &rec);
+};
+
+#endif
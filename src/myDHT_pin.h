@@ -0,0 +1,95 @@
+#ifndef MYDHT_PIN_H
+#define MYDHT_PIN_H
+
+#include "myDHT_config.h"
+#include <Arduino.h>
+
+/*
+  Pin access policies for the protocol loops in myDHT_protocol.h.
+
+  Any class with `uint8_t read() const` returning HIGH/LOW can be passed to mydht::captureFrame(),
+  e.g. a mock line on a host build. mydht::DHTPin is the backend chosen for the current board:
+    - RegisterPin: input register and bit mask cached once, read with a single load (AVR, SAMD, ESP32, ESP8266)
+    - ArduinoPin:  digitalRead() fallback for other cores, or when DHT_FAST_GPIO is 0
+
+  mydht::captureGroup() samples a whole port instead: any class with `read()` returning the port
+  bits works, RegisterPort being the one used on hardware.
+
+  Only reads are accelerated: writes and pinMode() happen around the start signal, outside the timed loop.
+*/
+
+// MYDHT_HOST_PORTS: the host mock core with port registers (extras/host, make PORTS=1)
+#if DHT_FAST_GPIO && (defined(__AVR__) || defined(ARDUINO_ARCH_SAMD) || defined(ESP32) || defined(ESP8266) || \
+                      defined(MYDHT_HOST_PORTS))
+#define DHT_PIN_REGISTER_BACKEND
+#endif
+
+namespace mydht
+{
+  // Portable backend using the Arduino API
+  class ArduinoPin
+  {
+  public:
+    explicit ArduinoPin(uint8_t pin) : _pin(pin) {}
+
+    uint8_t read() const { return digitalRead(_pin); }
+
+  private:
+    uint8_t _pin;
+  };
+
+#if defined(DHT_PIN_REGISTER_BACKEND)
+
+#if defined(__AVR__)
+  typedef uint8_t PortReg; // 8-bit ports
+#else
+  typedef uint32_t PortReg; // 32-bit ports
+#endif
+
+  // Direct register backend: port lookup done once in the constructor instead of on every read
+  class RegisterPin
+  {
+  public:
+    explicit RegisterPin(uint8_t pin)
+    {
+#if defined(ESP8266)
+      if (pin == 16) // GPIO16 is not part of GPI
+      {
+        _in = (const volatile PortReg *)&GP16I;
+        _mask = 1;
+        return;
+      }
+#endif
+      _in = portInputRegister(digitalPinToPort(pin));
+      _mask = digitalPinToBitMask(pin);
+    }
+
+    uint8_t read() const { return (*_in & _mask) ? HIGH : LOW; }
+
+    const volatile PortReg *port() const { return _in; } // Pins with the same port can be captured together
+    PortReg mask() const { return _mask; }
+
+  private:
+    const volatile PortReg *_in;
+    PortReg _mask;
+  };
+
+  // Whole input register, one load per sample for all pins on the port
+  class RegisterPort
+  {
+  public:
+    explicit RegisterPort(const volatile PortReg *in) : _in(in) {}
+
+    PortReg read() const { return *_in; }
+
+  private:
+    const volatile PortReg *_in;
+  };
+
+  typedef RegisterPin DHTPin;
+#else
+  typedef ArduinoPin DHTPin;
+#endif
+}
+
+#endif
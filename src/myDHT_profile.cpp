@@ -0,0 +1,84 @@
+#include "myDHT_profile.h"
+#include <string.h>
+
+namespace
+{
+    void putU16(uint8_t *out, uint16_t v)
+    {
+        out[0] = (uint8_t)v;
+        out[1] = (uint8_t)(v >> 8);
+    }
+
+    uint16_t getU16(const uint8_t *in)
+    {
+        return in[0] | ((uint16_t)in[1] << 8);
+    }
+
+    // Floats by their bit pattern, so the record reads the same on every target
+    void putFloat(uint8_t *out, float f)
+    {
+        uint32_t bits;
+        memcpy(&bits, &f, sizeof(bits));
+        putU16(out, (uint16_t)bits);
+        putU16(out + 2, (uint16_t)(bits >> 16));
+    }
+
+    float getFloat(const uint8_t *in)
+    {
+        uint32_t bits = getU16(in) | ((uint32_t)getU16(in + 2) << 16);
+        float f;
+        memcpy(&f, &bits, sizeof(f));
+        return f;
+    }
+}
+
+uint16_t mydht::crc16(const uint8_t *data, uint8_t len)
+{
+    uint16_t crc = 0xFFFF;
+    while (len--)
+    {
+        crc ^= (uint16_t)*data++ << 8;
+        for (uint8_t i = 0; i < 8; i++)
+            crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : crc << 1;
+    }
+    return crc;
+}
+
+void DHTProfile::encode(uint8_t *out) const
+{
+    out[0] = DHT_PROFILE_MAGIC;
+    out[1] = DHT_PROFILE_VERSION;
+    out[2] = pin;
+    out[3] = type;
+    out[4] = adaptiveTiming ? 1 : 0;
+    out[5] = retries;
+    putFloat(out + 6, tempOffsetC);
+    putFloat(out + 10, humidityOffset);
+    putU16(out + 14, highThresholdUs);
+    putU16(out + 16, bitTimeoutUs);
+    putU16(out + 18, zeroHighQ4);
+    putU16(out + 20, oneHighQ4);
+    putU16(out + 22, mydht::crc16(out, DHT_PROFILE_BYTES - 2));
+}
+
+bool DHTProfile::decode(const uint8_t *in, DHTProfile &profile)
+{
+    if (in[0] != DHT_PROFILE_MAGIC || in[1] != DHT_PROFILE_VERSION)
+        return false;
+    if (getU16(in + 22) != mydht::crc16(in, DHT_PROFILE_BYTES - 2))
+        return false;
+    if (in[3] != DHT11 && in[3] != DHT22)
+        return false;
+
+    profile.pin = in[2];
+    profile.type = (DHTType)in[3];
+    profile.adaptiveTiming = in[4] & 1;
+    profile.retries = in[5];
+    profile.tempOffsetC = getFloat(in + 6);
+    profile.humidityOffset = getFloat(in + 10);
+    profile.highThresholdUs = getU16(in + 14);
+    profile.bitTimeoutUs = getU16(in + 16);
+    profile.zeroHighQ4 = getU16(in + 18);
+    profile.oneHighQ4 = getU16(in + 20);
+    return true;
+}
@@ -0,0 +1,69 @@
+#ifndef MYDHT_PROFILE_H
+#define MYDHT_PROFILE_H
+
+#include "myDHTPro.h"
+
+/*
+  Sensor profile: what begin() would otherwise rediscover on every boot (model, timing, calibration).
+  Saved with MyDHT::saveProfile() and restored with loadProfile() before begin(); a restored sensor
+  skips the type detection and waits only getMinReadInterval() instead of the 3 s power-up delay.
+
+  Stored record, DHT_PROFILE_BYTES bytes, multi-byte fields little-endian:
+
+    0      DHT_PROFILE_MAGIC
+    1      DHT_PROFILE_VERSION
+    2      pin
+    3      type (DHT11 / DHT22)
+    4      flags: bit 0 adaptive timing
+    5      retries
+    6-9    temperature offset, °C (IEEE float)
+    10-13  humidity offset, %RH (IEEE float)
+    14-15  HIGH threshold, µs
+    16-17  bit timeout, µs
+    18-19  learned 0-bit HIGH width, 1/16 µs (0 = not learned)
+    20-21  learned 1-bit HIGH width, 1/16 µs
+    22-23  CRC-16/CCITT-FALSE of bytes 0-21
+
+  Records with another magic, version or a bad CRC are rejected, so erased (0xFF) or stale
+  storage simply means "no profile".
+*/
+
+#define DHT_PROFILE_BYTES 24
+#define DHT_PROFILE_MAGIC 0xD9
+#define DHT_PROFILE_VERSION 1
+
+struct DHTProfile
+{
+  uint8_t pin;
+  DHTType type;
+  bool adaptiveTiming;
+  uint8_t retries;
+  float tempOffsetC;
+  float humidityOffset;
+  uint16_t highThresholdUs;
+  uint16_t bitTimeoutUs;
+  uint16_t zeroHighQ4; // Learned widths in 1/16 µs, 0 until learned
+  uint16_t oneHighQ4;
+
+  void encode(uint8_t *out) const;                         // Writes DHT_PROFILE_BYTES bytes
+  static bool decode(const uint8_t *in, DHTProfile &profile); // false if magic, version or CRC do not match
+};
+
+/*
+  Where profiles live: EEPROM, flash, NVS, FRAM, a file on a host...
+  Implement read() and write() for your storage; myDHT_storage.h has EEPROM and ESP32 NVS versions.
+*/
+class DHTProfileStorage
+{
+public:
+  virtual ~DHTProfileStorage() = default;
+  virtual bool read(uint16_t address, uint8_t *data, uint8_t len) = 0;
+  virtual bool write(uint16_t address, const uint8_t *data, uint8_t len) = 0;
+};
+
+namespace mydht
+{
+  uint16_t crc16(const uint8_t *data, uint8_t len); // CRC-16/CCITT-FALSE (poly 0x1021, init 0xFFFF)
+}
+
+#endif
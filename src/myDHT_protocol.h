@@ -0,0 +1,213 @@
+#ifndef MYDHT_PROTOCOL_H
+#define MYDHT_PROTOCOL_H
+
+#include "myDHTPro.h"
+#include "myDHT_pin.h"
+
+/*
+  DHT single-wire protocol loops shared by MyDHT and MyDHTTyped<>.
+
+  The Timing parameter only needs the DHTTimings member names:
+    - MyDHT passes its runtime DHTTimings
+    - MyDHTTyped<> passes DHTModel<T>, whose constexpr members are folded into the loops
+  The Pin parameter is a pin access policy from myDHT_pin.h (normally mydht::DHTPin).
+*/
+namespace mydht
+{
+  // Pulls the line LOW for startLowMs, then releases it so the sensor can answer
+  inline void sendStartSignal(uint8_t pin, uint16_t startLowMs)
+  {
+    pinMode(pin, OUTPUT);
+    digitalWrite(pin, LOW);
+    delay(startLowMs); // Pull LOW (18ms for DHT11, 2ms for DHT22)
+    digitalWrite(pin, HIGH);
+    delayMicroseconds(30); // Then pull HIGH for 30µs
+    pinMode(pin, INPUT_PULLUP);
+  }
+
+  // Group version of sendStartSignal(): all lines are pulled LOW together and released back to back
+  inline void sendGroupStartSignal(const uint8_t *pins, uint8_t n, uint16_t startLowMs)
+  {
+    for (uint8_t k = 0; k < n; k++)
+    {
+      pinMode(pins[k], OUTPUT);
+      digitalWrite(pins[k], LOW);
+    }
+    delay(startLowMs); // Longest start pulse of the group
+    for (uint8_t k = 0; k < n; k++)
+      digitalWrite(pins[k], HIGH);
+    delayMicroseconds(30);
+    for (uint8_t k = 0; k < n; k++)
+      pinMode(pins[k], INPUT_PULLUP);
+  }
+
+  // Pulse durations are stored as 8-bit µs; anything longer than a bit window saturates at 255
+  inline uint8_t durationUs8(unsigned long us)
+  {
+    return us > 255 ? 255 : (uint8_t)us;
+  }
+
+  /*
+    Spins until the line reaches level, in a minimal loop (one pin read and one micros() per pass).
+    @param stamp In: timestamp of the previous edge. Out: timestamp of this edge.
+    @return false if the level did not change within limitUs
+  */
+  template <class Pin>
+  inline bool waitEdge(const Pin &io, uint8_t level, unsigned long &stamp, uint16_t limitUs)
+  {
+    unsigned long now = micros();
+    while (io.read() != level)
+    {
+      now = micros();
+      if (now - stamp > limitUs)
+        return false;
+    }
+    stamp = now;
+    return true;
+  }
+
+  /*
+    Capture phase: records the ACK and the LOW/HIGH durations (8-bit µs) of all 40 bits.
+    Must start right after the line is released. Does no decoding, so nothing but the
+    edge loop runs while the sensor is transmitting.
+    @return DHT_OK, DHT_ERROR_NO_RESPONSE, DHT_ERROR_TIMEOUT or DHT_ERROR_BIT_TIMEOUT
+  */
+  template <class Pin, class Timing>
+  DHTError captureFrame(const Pin &io, const Timing &t, uint8_t *highTimes, uint8_t *lowTimes)
+  {
+    unsigned long stamp = micros();
+
+    // ACK: sensor pulls LOW, releases HIGH (~80µs each), then pulls LOW for the first bit
+    if (!waitEdge(io, LOW, stamp, t.ackTimeoutUs))
+      return DHT_ERROR_NO_RESPONSE;
+    if (!waitEdge(io, HIGH, stamp, t.ackTimeoutUs) || !waitEdge(io, LOW, stamp, t.ackTimeoutUs))
+      return DHT_ERROR_TIMEOUT;
+
+    for (uint8_t i = 0; i < 40; i++)
+    {
+      unsigned long edge = stamp;
+      if (!waitEdge(io, HIGH, stamp, t.bitTimeoutUs))
+        return DHT_ERROR_BIT_TIMEOUT;
+      lowTimes[i] = durationUs8(stamp - edge);
+
+      edge = stamp;
+      if (!waitEdge(io, LOW, stamp, t.bitTimeoutUs))
+        return DHT_ERROR_BIT_TIMEOUT;
+      highTimes[i] = durationUs8(stamp - edge);
+    }
+
+    return DHT_OK;
+  }
+
+  /*
+    Group capture phase: records the frames of up to DHT_GROUP_MAX_PINS sensors sharing one port.
+    Each pass reads the port once; only lines whose bit changed are updated, so the sampling loop
+    stays almost as short as captureFrame()'s. Must start right after sendGroupStartSignal().
+    Per-line timeouts are checked after the capture from the stored durations.
+    @param masks  Bit of each line in the value returned by port.read()
+    @param errors Out: result of each line, same codes as captureFrame()
+  */
+  template <class Port, class Bits, class Timing>
+  void captureGroup(const Port &port, const Bits *masks, uint8_t n, const Timing &t,
+                    uint8_t *const *highTimes, uint8_t *const *lowTimes, DHTError *errors)
+  {
+    uint8_t edges[DHT_GROUP_MAX_PINS];
+    unsigned long last[DHT_GROUP_MAX_PINS];
+    Bits active = 0;
+
+    unsigned long stamp = micros(); // Most recent edge on any line
+    for (uint8_t k = 0; k < n; k++)
+    {
+      edges[k] = 0;
+      last[k] = stamp;
+      active |= masks[k];
+    }
+
+    // Released lines are HIGH: a sensor that already answered shows up as its first edge
+    Bits prev = active;
+    uint16_t limitUs = t.ackTimeoutUs;
+
+    while (active)
+    {
+      Bits level = port.read();
+      unsigned long now = micros();
+      Bits changed = (level ^ prev) & active;
+      prev = level;
+
+      if (!changed)
+      {
+        if (now - stamp > limitUs)
+          break; // Remaining lines went quiet
+        continue;
+      }
+
+      stamp = now;
+      limitUs = t.bitTimeoutUs;
+      for (uint8_t k = 0; k < n; k++)
+      {
+        if (!(changed & masks[k]))
+          continue;
+
+        uint8_t idx = edges[k]++; // Same edge numbering as MyDHT::onPinEdge()
+        if (idx >= 3)
+        {
+          uint8_t bit = (idx - 3) >> 1;
+          if ((idx - 3) & 1)
+            highTimes[k][bit] = durationUs8(now - last[k]);
+          else
+            lowTimes[k][bit] = durationUs8(now - last[k]);
+        }
+        last[k] = now;
+
+        if (edges[k] == DHT_FRAME_EDGES)
+          active &= ~masks[k]; // Frame complete, ignore the trailing release edge
+      }
+    }
+
+    for (uint8_t k = 0; k < n; k++)
+    {
+      if (edges[k] == 0)
+        errors[k] = DHT_ERROR_NO_RESPONSE;
+      else if (edges[k] < 3)
+        errors[k] = DHT_ERROR_TIMEOUT;
+      else if (edges[k] < DHT_FRAME_EDGES)
+        errors[k] = DHT_ERROR_BIT_TIMEOUT;
+      else
+      {
+        errors[k] = DHT_OK;
+        for (uint8_t i = 0; i < 40; i++)
+        {
+          if (lowTimes[k][i] > t.bitTimeoutUs || highTimes[k][i] > t.bitTimeoutUs)
+          {
+            errors[k] = DHT_ERROR_BIT_TIMEOUT; // Line stalled while others kept the loop running
+            break;
+          }
+        }
+      }
+    }
+  }
+
+  /*
+    Decode phase: classifies the captured HIGH durations into 5 bytes (MSB first).
+    Checksum is not verified here.
+  */
+  template <class Timing>
+  void decodeFrame(const Timing &t, const uint8_t *highTimes, uint8_t *bytes)
+  {
+    for (uint8_t i = 0; i < 5; i++)
+    {
+      uint8_t value = 0;
+      for (uint8_t j = 0; j < 8; j++)
+        value = (value << 1) | (highTimes[i * 8 + j] > t.highThresholdUs ? 1 : 0);
+      bytes[i] = value;
+    }
+  }
+
+  // Checksum: low 8 bits of the sum of the first four bytes
+  inline bool checksumOk(const uint8_t *bytes)
+  {
+    return (uint8_t)(bytes[0] + bytes[1] + bytes[2] + bytes[3]) == bytes[4];
+  }
+}
+
+#endif
@@ -0,0 +1,96 @@
+#include "myDHT_queue.h"
+
+#if defined(__AVR__)
+#include <util/atomic.h>
+#endif
+
+namespace
+{
+    /*
+      Index handoff between producer and consumer. The GCC __atomic builtins work on every
+      supported core; for single bytes they compile to plain loads and stores plus the barriers
+      the core needs (none on AVR, where they only stop the compiler from reordering).
+    */
+    inline uint8_t loadAcquire(const uint8_t &index)
+    {
+        return __atomic_load_n(&index, __ATOMIC_ACQUIRE);
+    }
+
+    inline void storeRelease(uint8_t &index, uint8_t value)
+    {
+        __atomic_store_n(&index, value, __ATOMIC_RELEASE);
+    }
+
+    inline uint8_t loadOwn(const uint8_t &index) // The side's own index: nobody else writes it
+    {
+        return __atomic_load_n(&index, __ATOMIC_RELAXED);
+    }
+}
+
+DHTQueueBase::DHTQueueBase(DHTReading *slots, uint8_t size) : _slots(slots), _size(size) {}
+
+bool DHTQueueBase::push(const DHTReading &reading)
+{
+    uint8_t tail = loadOwn(_tail);
+    uint8_t next = (tail + 1 == _size) ? 0 : tail + 1;
+
+    if (next == loadAcquire(_head))
+    {
+#if defined(__AVR__)
+        _dropped++; // Read by the consumer with interrupts off
+#else
+        __atomic_store_n(&_dropped, (uint16_t)(_dropped + 1), __ATOMIC_RELAXED);
+#endif
+        return false;
+    }
+
+    _slots[tail] = reading;
+    storeRelease(_tail, next); // Publishes the slot
+    return true;
+}
+
+bool DHTQueueBase::pop(DHTReading &reading)
+{
+    uint8_t head = loadOwn(_head);
+    if (head == loadAcquire(_tail))
+        return false;
+
+    reading = _slots[head];
+    storeRelease(_head, (head + 1 == _size) ? 0 : head + 1); // Hands the slot back to the producer
+    return true;
+}
+
+uint8_t DHTQueueBase::drain(DHTReading *out, uint8_t max)
+{
+    uint8_t head = loadOwn(_head);
+    uint8_t tail = loadAcquire(_tail); // One acquire covers the whole batch
+    uint8_t n = 0;
+
+    while (n < max && head != tail)
+    {
+        out[n++] = _slots[head];
+        head = (head + 1 == _size) ? 0 : head + 1;
+    }
+
+    if (n)
+        storeRelease(_head, head);
+    return n;
+}
+
+uint8_t DHTQueueBase::available() const
+{
+    uint8_t head = loadAcquire(_head);
+    uint8_t tail = loadAcquire(_tail);
+    return (tail >= head) ? tail - head : _size - head + tail;
+}
+
+uint16_t DHTQueueBase::getDropped() const
+{
+#if defined(__AVR__)
+    uint16_t dropped;
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) { dropped = _dropped; } // Two bytes: the producer may be an ISR
+    return dropped;
+#else
+    return __atomic_load_n(&_dropped, __ATOMIC_RELAXED);
+#endif
+}
@@ -0,0 +1,74 @@
+#ifndef MYDHT_QUEUE_H
+#define MYDHT_QUEUE_H
+
+#include <stdint.h>
+
+class MyDHT;
+
+// One completed read, as posted to a DHTQueue
+struct DHTReading
+{
+  MyDHT *sensor;   // Sensor that produced the reading
+  uint32_t timeMs; // millis() when the read completed
+  uint16_t seq;    // Per-sensor sequence number; a gap means readings were dropped
+  int16_t tempC10; // °C in tenths, calibrated; DHT_FIXED_INVALID unless status is DHT_OK
+  uint16_t hum10;  // %RH in tenths, calibrated; DHT_FIXED_INVALID_HUM unless status is DHT_OK
+  uint8_t status;  // DHTError of the read (a sanity failure covered by the last valid data is reported as such)
+};
+
+/*
+  Allocation-free single-producer / single-consumer queue of DHTReading records.
+
+  Attach to sensors with MyDHT::setQueue() (or MultiDHTManager::setQueue()); every completed read,
+  blocking or async, then posts a record, and loop() drains them in batches. No locks: the producer
+  only writes the tail index and the consumer only the head index, each published with release
+  ordering after the slot is written or read, so the two sides may run in different contexts
+  (ISR / loop(), two tasks, two threads).
+
+  One producer per queue: sensors that share a queue must complete their reads in the same
+  context, e.g. all from loop() via processAsync(). When the queue is full the new record is
+  dropped and counted; the sequence numbers show which ones are missing.
+
+  Storage comes from DHTQueue<N>, this base class holds the shared code.
+*/
+class DHTQueueBase
+{
+public:
+  // Producer side
+  bool push(const DHTReading &reading); // false (and counted as dropped) if the queue is full
+
+  // Consumer side
+  bool pop(DHTReading &reading);                  // false if the queue is empty
+  uint8_t drain(DHTReading *out, uint8_t max);    // Pops up to max records, returns how many
+  uint8_t available() const;                      // Records waiting
+  uint16_t getDropped() const;                    // Records lost to a full queue since the start
+  uint8_t getCapacity() const { return _size - 1; }
+
+protected:
+  DHTQueueBase(DHTReading *slots, uint8_t size); // size = capacity + 1 (one slot stays empty)
+
+private:
+  DHTReading *_slots;
+  uint8_t _size;
+  uint8_t _head = 0;     // Next slot to pop, written by the consumer only
+  uint8_t _tail = 0;     // Next slot to push, written by the producer only
+  uint16_t _dropped = 0; // Written by the producer only
+};
+
+/*
+  Queue of N readings, (N + 1) * sizeof(DHTReading) bytes plus 6 bytes of state.
+  @tparam N Capacity, 1 to 254 records
+*/
+template <uint8_t N>
+class DHTQueue : public DHTQueueBase
+{
+  static_assert(N >= 1 && N <= 254, "DHTQueue must hold 1 to 254 readings");
+
+public:
+  DHTQueue() : DHTQueueBase(_storage, N + 1) {}
+
+private:
+  DHTReading _storage[N + 1];
+};
+
+#endif
@@ -0,0 +1,94 @@
+#include "myDHT_sampler.h"
+
+DHTAdaptiveSampler::DHTAdaptiveSampler(MyDHT &sensor) : _sensor(sensor) {}
+
+void DHTAdaptiveSampler::reset()
+{
+    _intervalMs = 0;
+    _hasLast = false;
+    _started = false;
+}
+
+bool DHTAdaptiveSampler::isDue() const
+{
+    return !_started || (long)(millis() - _dueMs) >= 0;
+}
+
+unsigned long DHTAdaptiveSampler::nextReadDueMs() const
+{
+    return _started ? _dueMs : millis();
+}
+
+DHTError DHTAdaptiveSampler::update()
+{
+    if (!isDue())
+        return _lastResult;
+
+    _lastResult = _sensor.read();
+    unsigned long now = millis();
+    _started = true;
+    _reads++;
+
+    // read() may cover a sanity failure with the last valid data: that is no new sample
+    if (_lastResult == DHT_OK && _sensor.getLastError() == DHT_OK)
+    {
+        adapt(_sensor.getTemperatureDeci(Celsius), _sensor.getHumidityDeci(), now);
+        _dueMs = now + _intervalMs;
+    }
+    else
+    {
+        _dueMs = now + _sensor.getMinReadInterval(); // Retry soon, keep the interval
+    }
+    return _lastResult;
+}
+
+/*
+  Next interval from the change since the previous good read: the time in which the faster
+  quantity moves by one step at the observed rate, clamped to the policy limits
+*/
+void DHTAdaptiveSampler::adapt(int16_t tempC10, uint16_t hum10, unsigned long nowMs)
+{
+    uint32_t minMs = _sensor.getMinReadInterval();
+    uint32_t maxMs = (_policy.maxIntervalMs > minMs) ? _policy.maxIntervalMs : minMs;
+
+    if (!_hasLast)
+    {
+        _intervalMs = minMs;
+    }
+    else
+    {
+        uint32_t elapsedMs = nowMs - _lastMs;
+        uint16_t dTemp = (tempC10 > _lastTempC10) ? tempC10 - _lastTempC10 : _lastTempC10 - tempC10;
+        uint16_t dHum = (hum10 > _lastHum10) ? hum10 - _lastHum10 : _lastHum10 - hum10;
+
+        uint64_t targetMs = maxMs;
+        if (dTemp)
+        {
+            uint64_t t = (uint64_t)elapsedMs * _policy.tempStepC10 / dTemp;
+            if (t < targetMs)
+                targetMs = t;
+        }
+        if (dHum)
+        {
+            uint64_t t = (uint64_t)elapsedMs * _policy.humStep10 / dHum;
+            if (t < targetMs)
+                targetMs = t;
+        }
+
+        // Widen gradually: one flat read says little about the next minutes
+        uint64_t grownMs = (uint64_t)(_intervalMs ? _intervalMs : minMs) * (_policy.growth > 1 ? _policy.growth : 1);
+        if (targetMs > grownMs)
+            targetMs = grownMs;
+
+        if (targetMs < minMs)
+            targetMs = minMs;
+        if (targetMs > maxMs)
+            targetMs = maxMs;
+        _intervalMs = (uint32_t)targetMs;
+    }
+
+    _lastMs = nowMs;
+    _lastTempC10 = tempC10;
+    _lastHum10 = hum10;
+    _hasLast = true;
+}
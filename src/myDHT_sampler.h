@@ -0,0 +1,63 @@
+#ifndef MYDHT_SAMPLER_H
+#define MYDHT_SAMPLER_H
+
+#include "myDHTPro.h"
+
+/*
+  How DHTAdaptiveSampler spaces its reads.
+  A step is the change per read that is worth a reading: the sampler aims for about one step
+  of change (in either quantity) between two reads, so the hold error stays near one step.
+*/
+struct DHTSamplingPolicy
+{
+  uint16_t tempStepC10;   // Temperature step, tenths of °C (3 = 0.3 °C)
+  uint16_t humStep10;     // Humidity step, tenths of %RH (10 = 1 %RH)
+  uint32_t maxIntervalMs; // Longest interval while both quantities are flat
+  uint8_t growth;         // Interval multiplier limit per read while flat (2 = at most double)
+};
+
+/*
+  Adaptive read scheduling on top of MyDHT. After every good read the rate of change since the
+  previous read gives the interval at which the faster quantity would move by one step:
+    - flat (less than a step per read): the interval widens, by at most policy.growth per read,
+      up to policy.maxIntervalMs
+    - moving (more than a step): it tightens right away, down to getMinReadInterval()
+  A failed read is retried after getMinReadInterval() without changing the interval.
+
+  Call update() as often as you like (it reads only when a read is due), or sleep until
+  nextReadDueMs() and call it then. The values stay in the sensor (getTemperature(), ...).
+*/
+class DHTAdaptiveSampler
+{
+public:
+  DHTAdaptiveSampler(MyDHT &sensor);
+
+  DHTError update();                    // Reads if due, else returns the last result without touching the sensor
+  unsigned long nextReadDueMs() const;  // millis() at which the next read is due
+  bool isDue() const;
+
+  void setPolicy(const DHTSamplingPolicy &policy) { _policy = policy; }
+  DHTSamplingPolicy getPolicy() const { return _policy; }
+
+  uint32_t getInterval() const { return _intervalMs; } // Current interval, ms
+  uint32_t getReadCount() const { return _reads; }      // Reads taken by update()
+  void reset();                                         // Back to the minimum interval, next read due now
+
+private:
+  MyDHT &_sensor;
+  DHTSamplingPolicy _policy = {3, 10, 60000, 2}; // 0.3 °C, 1 %RH, 60 s
+
+  uint32_t _intervalMs = 0;   // 0 until the first read: the minimum interval
+  unsigned long _lastMs = 0;  // millis() of the last good read
+  unsigned long _dueMs = 0;
+  int16_t _lastTempC10 = 0;
+  uint16_t _lastHum10 = 0;
+  bool _hasLast = false;
+  bool _started = false;      // First update() reads right away
+  DHTError _lastResult = DHT_OK;
+  uint32_t _reads = 0;
+
+  void adapt(int16_t tempC10, uint16_t hum10, unsigned long nowMs);
+};
+
+#endif
@@ -0,0 +1,174 @@
+#include "myDHT_service.h"
+
+#if DHT_SERVICE
+
+#include <string.h>
+
+namespace
+{
+    constexpr uint16_t MAX_WAIT_MS = 50; // The thread checks for stop() at least this often
+
+#if defined(ESP32)
+    constexpr uint32_t TASK_STACK_BYTES = 4096;
+    constexpr UBaseType_t TASK_PRIORITY = 1;
+#endif
+}
+
+DHTServiceBase::DHTServiceBase(Slot *slots, uint8_t capacity) : _slots(slots), _capacity(capacity) {}
+
+bool DHTServiceBase::add(MyDHT &sensor)
+{
+    if (_count >= _capacity || isRunning())
+        return false;
+
+    Slot &slot = _slots[_count++];
+    slot.sensor = &sensor;
+    slot.version = 0;
+    memset(slot.copies, 0, sizeof(slot.copies)); // No sensor in the record: no reading yet
+    return true;
+}
+
+void DHTServiceBase::setCallback(DHTReadingCallback cb, void *context)
+{
+    _callback = cb;
+    _context = context;
+}
+
+bool DHTServiceBase::start(uint16_t periodMs, int8_t core)
+{
+    if (isRunning())
+        return false;
+
+    _periodMs = periodMs;
+    unsigned long now = millis();
+    for (uint8_t i = 0; i < _count; i++)
+        _slots[i].dueMs = now; // First reading right away
+
+    __atomic_store_n(&_stop, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&_running, 1, __ATOMIC_RELEASE);
+
+#if defined(ESP32)
+    BaseType_t created = xTaskCreatePinnedToCore(threadEntry, "myDHT", TASK_STACK_BYTES, this, TASK_PRIORITY, nullptr,
+                                                 core < 0 ? tskNO_AFFINITY : core);
+    if (created != pdPASS)
+    {
+        __atomic_store_n(&_running, 0, __ATOMIC_RELEASE);
+        return false;
+    }
+#else
+    (void)core;
+    _thread = std::thread(threadEntry, this);
+#endif
+    return true;
+}
+
+void DHTServiceBase::stop()
+{
+    __atomic_store_n(&_stop, 1, __ATOMIC_RELEASE);
+
+#if defined(ESP32)
+    while (isRunning())
+        delay(1); // The task deletes itself after its current read
+#else
+    if (_thread.joinable())
+        _thread.join();
+#endif
+}
+
+bool DHTServiceBase::isRunning() const
+{
+    return __atomic_load_n(&_running, __ATOMIC_ACQUIRE);
+}
+
+void DHTServiceBase::threadEntry(void *service)
+{
+    static_cast<DHTServiceBase *>(service)->run();
+
+    __atomic_store_n(&static_cast<DHTServiceBase *>(service)->_running, 0, __ATOMIC_RELEASE);
+#if defined(ESP32)
+    vTaskDelete(nullptr);
+#endif
+}
+
+/*
+  Polling loop of the service thread: reads every sensor that is due, publishes the result and
+  sleeps until the next one is due
+*/
+void DHTServiceBase::run()
+{
+    while (!__atomic_load_n(&_stop, __ATOMIC_ACQUIRE))
+    {
+        unsigned long waitMs = MAX_WAIT_MS;
+
+        for (uint8_t i = 0; i < _count; i++)
+        {
+            Slot &slot = _slots[i];
+            MyDHT *sensor = slot.sensor;
+
+            if ((long)(millis() - slot.dueMs) >= 0)
+            {
+                DHTError err = sensor->read();
+                DHTReading reading = sensor->makeReading(err);
+                publishSnapshot(slot, reading);
+                if (_callback)
+                    _callback(reading, _context);
+
+                uint16_t intervalMs = sensor->getMinReadInterval();
+                slot.dueMs = reading.timeMs + (_periodMs > intervalMs ? _periodMs : intervalMs);
+            }
+
+            unsigned long leftMs = slot.dueMs - millis();
+            if ((long)leftMs < 0)
+                leftMs = 0;
+            if (leftMs < waitMs)
+                waitMs = leftMs;
+        }
+
+        if (waitMs)
+            delay(waitMs); // vTaskDelay() on ESP32: the core is free for other tasks
+    }
+}
+
+/*
+  Latch write: the version goes odd while copy 0 is rewritten (readers use copy 1), then even while
+  copy 1 is rewritten (readers use copy 0). A reader only retries if the version changed during its copy.
+*/
+void DHTServiceBase::publishSnapshot(Slot &slot, const DHTReading &reading)
+{
+    uint32_t words[READING_WORDS] = {};
+    memcpy(words, &reading, sizeof(reading));
+
+    uint32_t version = __atomic_load_n(&slot.version, __ATOMIC_RELAXED);
+    for (uint8_t copy = 0; copy < 2; copy++)
+    {
+        __atomic_store_n(&slot.version, ++version, __ATOMIC_RELEASE); // Earlier copy complete before the switch
+        __atomic_thread_fence(__ATOMIC_RELEASE);                      // Switch visible before the new words
+
+        for (uint8_t w = 0; w < READING_WORDS; w++)
+            __atomic_store_n(&slot.copies[copy][w], words[w], __ATOMIC_RELAXED);
+    }
+}
+
+bool DHTServiceBase::getLatest(uint8_t index, DHTReading &reading) const
+{
+    if (index >= _count)
+        return false;
+
+    const Slot &slot = _slots[index];
+    uint32_t words[READING_WORDS];
+    uint32_t version;
+
+    do
+    {
+        version = __atomic_load_n(&slot.version, __ATOMIC_ACQUIRE);
+        const uint32_t *copy = slot.copies[version & 1];
+        for (uint8_t w = 0; w < READING_WORDS; w++)
+            words[w] = __atomic_load_n(&copy[w], __ATOMIC_RELAXED);
+        __atomic_thread_fence(__ATOMIC_ACQUIRE); // Copy complete before the version is checked again
+    } while (__atomic_load_n(&slot.version, __ATOMIC_RELAXED) != version);
+
+    memcpy(&reading, words, sizeof(reading));
+    return reading.sensor != nullptr; // Both copies are written by the first publish
+}
+
+#endif
@@ -0,0 +1,108 @@
+#ifndef MYDHT_SERVICE_H
+#define MYDHT_SERVICE_H
+
+#include "myDHTPro.h"
+
+#if DHT_SERVICE
+
+#if !defined(ESP32)
+#include <thread>
+#endif
+
+// Called in the service thread after every read, with the record that was just published
+typedef void (*DHTReadingCallback)(const DHTReading &reading, void *context);
+
+/*
+  Background sensor service for targets with threads (DHT_SERVICE: ESP32, host builds).
+
+  Owns a set of MyDHT instances and reads them on a FreeRTOS task (ESP32) or a std::thread (host),
+  each at getMinReadInterval() or a longer period. Every result is published as a DHTReading
+  snapshot that any number of other tasks fetch with getLatest() at any time, on any core.
+
+  Snapshots use a latched sequence counter (two copies per sensor): while the service rewrites one
+  copy, readers are sent to the other, so a reader never waits for the writer and never sees half
+  an update; it only retries if a whole new reading was published during its copy. No locks, no
+  allocation.
+
+  Between start() and stop() the sensors belong to the service thread: other tasks must not call
+  their read functions or getters (getTemperature() decodes bytes the service may be rewriting).
+  Queues attached with MyDHT::setQueue() work as usual, with the service thread as the producer.
+
+  Storage comes from DHTService<N>, this base class holds the shared code.
+*/
+class DHTServiceBase
+{
+public:
+  bool add(MyDHT &sensor); // Call begin() on the sensor first; false when full or running
+
+  /*
+    Starts the polling thread.
+    @param periodMs Time between two reads of a sensor; 0 or anything below getMinReadInterval() uses the minimum
+    @param core     ESP32: core of the task (0 or 1), -1 for any; ignored on a host
+    @return false if already running or the thread could not be created
+  */
+  bool start(uint16_t periodMs = 0, int8_t core = -1);
+  void stop(); // Waits for the current read to finish
+  bool isRunning() const;
+
+  // Latest snapshot of sensor index, from any task; never blocks. false until its first reading
+  bool getLatest(uint8_t index, DHTReading &reading) const;
+
+  // Runs in the service thread after each read; set it before start()
+  void setCallback(DHTReadingCallback cb, void *context = nullptr);
+
+  uint8_t getCount() const { return _count; }
+  MyDHT *getSensor(uint8_t index) const { return _slots[index].sensor; }
+
+protected:
+  static constexpr uint8_t READING_WORDS = (sizeof(DHTReading) + 3) / 4;
+
+  struct Slot
+  {
+    MyDHT *sensor;
+    unsigned long dueMs; // Service thread only
+    uint32_t version;    // Incremented before each copy is rewritten; readers use copy (version & 1)
+    uint32_t copies[2][READING_WORDS];
+  };
+
+  DHTServiceBase(Slot *slots, uint8_t capacity);
+
+private:
+  Slot *_slots;
+  uint8_t _capacity;
+  uint8_t _count = 0;
+  uint16_t _periodMs = 0;
+  uint8_t _running = 0; // Set by start(), cleared by the thread when it exits
+  uint8_t _stop = 0;    // Asks the thread to exit
+  DHTReadingCallback _callback = nullptr;
+  void *_context = nullptr;
+
+#if !defined(ESP32)
+  std::thread _thread;
+#endif
+
+  static void threadEntry(void *service);
+  void run();
+  void publishSnapshot(Slot &slot, const DHTReading &reading);
+};
+
+/*
+  Service for up to N sensors, about (8 + 2 * sizeof(DHTReading)) bytes per sensor.
+  @tparam N Number of sensors
+*/
+template <uint8_t N>
+class DHTService : public DHTServiceBase
+{
+  static_assert(N >= 1, "DHTService needs room for at least one sensor");
+
+public:
+  DHTService() : DHTServiceBase(_storage, N) {}
+  ~DHTService() { stop(); }
+
+private:
+  Slot _storage[N];
+};
+
+#endif
+
+#endif
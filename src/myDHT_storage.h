@@ -0,0 +1,97 @@
+#ifndef MYDHT_STORAGE_H
+#define MYDHT_STORAGE_H
+
+#include "myDHT_profile.h"
+
+/*
+  Ready-made DHTProfileStorage backends. Header-only on purpose: the EEPROM and Preferences
+  libraries are only pulled into sketches that include this file.
+
+    DHTEepromStorage       EEPROM library (AVR EEPROM, ESP8266 / ESP32 flash emulation);
+                           DHT_EEPROM_STORAGE is 1 where it is available
+    DHTPreferencesStorage  ESP32 NVS through the Preferences library, one key per address
+
+  Other storage (external flash, FRAM, SD, a host file) only needs read() and write().
+*/
+
+#if defined(ARDUINO_ARCH_AVR) || defined(ESP8266) || defined(ESP32)
+#include <EEPROM.h>
+#define DHT_EEPROM_STORAGE 1
+
+/*
+  Profiles at EEPROM byte addresses, DHT_PROFILE_BYTES each.
+  On ESP8266 / ESP32 call EEPROM.begin(size) first; write() commits the emulated page.
+*/
+class DHTEepromStorage : public DHTProfileStorage
+{
+public:
+  bool read(uint16_t address, uint8_t *data, uint8_t len) override
+  {
+    if ((uint32_t)address + len > EEPROM.length())
+      return false;
+    for (uint8_t i = 0; i < len; i++)
+      data[i] = EEPROM.read(address + i);
+    return true;
+  }
+
+  bool write(uint16_t address, const uint8_t *data, uint8_t len) override
+  {
+    if ((uint32_t)address + len > EEPROM.length())
+      return false;
+#if defined(ESP8266) || defined(ESP32)
+    for (uint8_t i = 0; i < len; i++)
+      EEPROM.write(address + i, data[i]);
+    return EEPROM.commit();
+#else
+    for (uint8_t i = 0; i < len; i++)
+      EEPROM.update(address + i, data[i]); // Unchanged cells are not rewritten
+    return true;
+#endif
+  }
+};
+#else
+#define DHT_EEPROM_STORAGE 0
+#endif
+
+#if defined(ESP32)
+#include <Preferences.h>
+
+/*
+  Profiles in NVS: key "p<address>" in the given namespace (default "mydht").
+  NVS does its own wear levelling and survives firmware updates that keep the partition.
+*/
+class DHTPreferencesStorage : public DHTProfileStorage
+{
+public:
+  DHTPreferencesStorage(const char *ns = "mydht") : _ns(ns) {}
+
+  bool read(uint16_t address, uint8_t *data, uint8_t len) override
+  {
+    char key[8];
+    snprintf(key, sizeof(key), "p%u", address);
+    Preferences prefs;
+    if (!prefs.begin(_ns, true))
+      return false;
+    bool ok = prefs.getBytes(key, data, len) == len;
+    prefs.end();
+    return ok;
+  }
+
+  bool write(uint16_t address, const uint8_t *data, uint8_t len) override
+  {
+    char key[8];
+    snprintf(key, sizeof(key), "p%u", address);
+    Preferences prefs;
+    if (!prefs.begin(_ns, false))
+      return false;
+    bool ok = prefs.putBytes(key, data, len) == len;
+    prefs.end();
+    return ok;
+  }
+
+private:
+  const char *_ns;
+};
+#endif
+
+#endif
@@ -0,0 +1,180 @@
+#include "myDHT_trace.h"
+#include "myDHTPro.h"
+#include <stdio.h>
+
+DHTTraceRecord *DHTTrace::_buffer = nullptr;
+uint8_t DHTTrace::_capacity = 0;
+uint8_t DHTTrace::_head = 0;
+uint8_t DHTTrace::_count = 0;
+uint16_t DHTTrace::_dropped = 0;
+
+void DHTTrace::begin(DHTTraceRecord *buffer, uint8_t capacity)
+{
+    _buffer = buffer;
+    _capacity = capacity;
+    clear();
+}
+
+void DHTTrace::end()
+{
+    _buffer = nullptr;
+    _capacity = 0;
+    clear();
+}
+
+void DHTTrace::clear()
+{
+    _head = 0;
+    _count = 0;
+    _dropped = 0;
+}
+
+void DHTTrace::record(DHTTraceEvent event, uint8_t pin, uint16_t a, uint32_t b)
+{
+    if (!_capacity)
+        return;
+
+    uint16_t slot = _head + _count;
+    if (slot >= _capacity)
+        slot -= _capacity;
+
+    if (_count == _capacity)
+    {
+        // Full: overwrite the oldest event
+        _head = (_head + 1 == _capacity) ? 0 : _head + 1;
+        if (_dropped < 0xFFFF)
+            _dropped++;
+    }
+    else
+    {
+        _count++;
+    }
+
+    DHTTraceRecord &rec = _buffer[slot];
+    rec.timeUs = micros();
+    rec.event = event;
+    rec.pin = pin;
+    rec.a = a;
+    rec.b = b;
+}
+
+bool DHTTrace::pop(DHTTraceRecord &rec)
+{
+    if (!_count)
+        return false;
+
+    rec = _buffer[_head];
+    _head = (_head + 1 == _capacity) ? 0 : _head + 1;
+    _count--;
+    return true;
+}
+
+/*
+  The messages of the former debugPrint() calls, rebuilt from the event arguments
+*/
+size_t DHTTrace::format(const DHTTraceRecord &rec, char *buf, size_t len)
+{
+    int n;
+    switch (rec.event)
+    {
+    case DHT_TRACE_READ_ATTEMPT:
+        n = snprintf(buf, len, "Read attempt %u/%lu", rec.a, (unsigned long)rec.b);
+        break;
+    case DHT_TRACE_READ_RESULT:
+        n = snprintf(buf, len, "Read result: %s", mydht::errorString((DHTError)rec.a));
+        break;
+    case DHT_TRACE_ATTEMPT_START:
+        n = snprintf(buf, len, "Starting single read attempt on pin %u", rec.pin);
+        break;
+    case DHT_TRACE_ATTEMPT_RESULT:
+        n = snprintf(buf, len, "readOnce result: %s", mydht::errorString((DHTError)rec.a));
+        break;
+    case DHT_TRACE_RAW_BYTES:
+        n = snprintf(buf, len, "Raw bytes: %02X %02X %02X %02X %02X", rec.a >> 8, rec.a & 0xFF,
+                     (unsigned)(rec.b >> 16) & 0xFF, (unsigned)(rec.b >> 8) & 0xFF, (unsigned)rec.b & 0xFF);
+        break;
+    case DHT_TRACE_CHECKSUM_MISMATCH:
+        n = snprintf(buf, len, "Checksum mismatch: %02X != %02X", rec.a, (unsigned)rec.b);
+        break;
+    case DHT_TRACE_DECODE_OK:
+        n = snprintf(buf, len, "Decode: OK, checksum verified");
+        break;
+    case DHT_TRACE_CHECKSUM_RECOVERED:
+        n = snprintf(buf, len, "Checksum recovered with frame threshold %u us", rec.a);
+        break;
+    case DHT_TRACE_ASYNC_RETRY:
+        n = snprintf(buf, len, "Async attempt %u failed (%s), retry in %lu ms", rec.a & 0xFF,
+                     mydht::errorString((DHTError)(rec.a >> 8)), (unsigned long)rec.b);
+        break;
+    case DHT_TRACE_SANITY:
+        n = snprintf(buf, len, "Sanity check %s: Temp=%d, Hum=%u (tenths)", rec.a ? "passed" : "failed",
+                     (int16_t)(rec.b >> 16), (unsigned)(rec.b & 0xFFFF));
+        break;
+    default:
+        n = snprintf(buf, len, "Unknown event %u", rec.event);
+        break;
+    }
+    return n < 0 ? 0 : (size_t)n;
+}
+
+size_t DHTTrace::print(Print &out)
+{
+    size_t written = 0;
+    char line[96];
+    DHTTraceRecord rec;
+
+    if (_dropped)
+    {
+        snprintf(line, sizeof(line), "[DHT DEBUG] %u events dropped", _dropped);
+        written += out.println(line);
+        _dropped = 0;
+    }
+
+    while (pop(rec))
+    {
+        written += out.print("[DHT DEBUG] ");
+        format(rec, line, sizeof(line));
+        written += out.println(line);
+    }
+    return written;
+}
+
+size_t DHTTrace::flush(Print &out)
+{
+    uint8_t header[2] = {DHT_TRACE_MAGIC, _count};
+    size_t written = out.write(header, sizeof(header));
+
+    DHTTraceRecord rec;
+    while (pop(rec))
+    {
+        uint8_t bytes[DHT_TRACE_RECORD_BYTES];
+        for (uint8_t i = 0; i < 4; i++)
+        {
+            bytes[i] = (uint8_t)(rec.timeUs >> (8 * i));
+            bytes[8 + i] = (uint8_t)(rec.b >> (8 * i));
+        }
+        bytes[4] = rec.event;
+        bytes[5] = rec.pin;
+        bytes[6] = (uint8_t)rec.a;
+        bytes[7] = (uint8_t)(rec.a >> 8);
+        written += out.write(bytes, sizeof(bytes));
+    }
+    _dropped = 0;
+    return written;
+}
+
+DHTTraceRecord DHTTrace::decode(const uint8_t *bytes)
+{
+    DHTTraceRecord rec;
+    rec.timeUs = 0;
+    rec.b = 0;
+    for (uint8_t i = 0; i < 4; i++)
+    {
+        rec.timeUs |= (uint32_t)bytes[i] << (8 * i);
+        rec.b |= (uint32_t)bytes[8 + i] << (8 * i);
+    }
+    rec.event = bytes[4];
+    rec.pin = bytes[5];
+    rec.a = bytes[6] | (bytes[7] << 8);
+    return rec;
+}
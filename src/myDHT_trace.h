@@ -0,0 +1,79 @@
+#ifndef MYDHT_TRACE_H
+#define MYDHT_TRACE_H
+
+#include <Arduino.h>
+
+/*
+  Deferred debug trace. With debugMode on, MyDHT records compact events (ID plus integer
+  arguments) into a ring buffer instead of formatting text: a few stores per event, no snprintf,
+  no Serial, so the read timing stays what it is without debugging.
+
+  Nothing is recorded (and no RAM is used) until DHTTrace::begin() gets a buffer.
+  Render the events as text with DHTTrace::print(), or send them in binary with flush()
+  and render them on a PC with the extras/dhttrace tool.
+*/
+
+// Event IDs; the arguments of each event are listed with its message
+enum DHTTraceEvent : uint8_t
+{
+  DHT_TRACE_READ_ATTEMPT,       // "Read attempt a/b"
+  DHT_TRACE_READ_RESULT,        // "Read result: error a"
+  DHT_TRACE_ATTEMPT_START,      // "Starting single read attempt on pin"
+  DHT_TRACE_ATTEMPT_RESULT,     // "readOnce result: error a"
+  DHT_TRACE_RAW_BYTES,          // "Raw bytes": a = bytes 0-1, b = bytes 2-4
+  DHT_TRACE_CHECKSUM_MISMATCH,  // "Checksum mismatch: a != b"
+  DHT_TRACE_DECODE_OK,          // "Decode: OK, checksum verified"
+  DHT_TRACE_CHECKSUM_RECOVERED, // "Checksum recovered with frame threshold a us"
+  DHT_TRACE_ASYNC_RETRY,        // "Async attempt (a & 0xFF) failed (error a >> 8), retry in b ms"
+  DHT_TRACE_SANITY,             // "Sanity check passed/failed (a)": b = temperature << 16 | humidity, tenths
+  DHT_TRACE_EVENT_COUNT
+};
+
+// One trace event, 12 bytes
+struct DHTTraceRecord
+{
+  uint32_t timeUs; // micros() when the event was recorded
+  uint8_t event;   // DHTTraceEvent
+  uint8_t pin;     // Sensor pin
+  uint16_t a;
+  uint32_t b;
+};
+
+// Bytes of a record in the flush() stream, after a 2-byte batch header (DHT_TRACE_MAGIC, count)
+#define DHT_TRACE_RECORD_BYTES 12
+#define DHT_TRACE_MAGIC 0xD7
+
+class DHTTrace
+{
+public:
+  // Starts tracing into caller storage; the oldest events are overwritten when it is full
+  static void begin(DHTTraceRecord *buffer, uint8_t capacity);
+  static void end(); // Stops tracing and releases the buffer
+
+  // Records one event: a handful of stores, safe to call in timing-sensitive code
+  static void record(DHTTraceEvent event, uint8_t pin, uint16_t a = 0, uint32_t b = 0);
+
+  static uint8_t available() { return _count; }
+  static uint16_t getDropped() { return _dropped; } // Events overwritten before they were flushed
+  static void clear();
+
+  static size_t print(Print &out); // Renders and removes the pending events as "[DHT DEBUG] ..." lines
+  static size_t flush(Print &out); // Writes and removes the pending events in binary (one batch)
+
+  // Renders one event as text, without the prefix; shared with the host decoder
+  static size_t format(const DHTTraceRecord &rec, char *buf, size_t len);
+
+  // Reads a record from flush() output (little-endian), the inverse of the binary encoding
+  static DHTTraceRecord decode(const uint8_t *bytes);
+
+private:
+  static DHTTraceRecord *_buffer;
+  static uint8_t _capacity;
+  static uint8_t _head; // Oldest pending event
+  static uint8_t _count;
+  static uint16_t _dropped;
+
+  static bool pop(DHTTraceRecord &rec);
+};
+
+#endif